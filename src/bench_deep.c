@@ -0,0 +1,147 @@
+/** @file
+   Pomiar czasu operacji na głęboko zagnieżdżonych wielomianach
+
+   Program mierzy czas PolyClone(), PolyIsEq(), PolyDeg(), PolyDegBy()
+   i PolyDestroy() na dwóch rodzajach wielomianów:
+   - łańcuchu @f$x_0 x_1 \cdots x_{d-1}@f$ o głębokości @p d,
+   - pełnym drzewie o zadanej głębokości i liczbie jednomianów w każdym
+     wielomianie.
+
+   Kompilacja: `cc -std=c11 -O2 bench_deep.c poly.c -o bench_deep`,
+   uruchomienie: `./bench_deep [głębokość łańcucha] [głębokość drzewa]
+   [szerokość drzewa]`.
+
+   @copyright Uniwersytet Warszawski
+   @date 2026-10-19
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "poly.h"
+
+/**
+ * Domyślna głębokość łańcucha
+ */
+#define DEFAULT_CHAIN_DEPTH 200000
+
+/**
+ * Domyślna głębokość drzewa
+ */
+#define DEFAULT_TREE_DEPTH 6
+
+/**
+ * Domyślna liczba jednomianów w każdym wielomianie drzewa
+ */
+#define DEFAULT_TREE_WIDTH 8
+
+/**
+ * Zwraca bieżący czas w sekundach
+ * @return czas
+ */
+static double Now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+}
+
+/**
+ * Tworzy łańcuch @f$x_0 x_1 \cdots x_{depth-1}@f$
+ * @param depth : głębokość łańcucha
+ * @return wielomian
+ */
+static Poly MakeChain(unsigned depth) {
+    Poly p = PolyFromCoeff(1);
+    for (unsigned i = 0; i < depth; i++) {
+        PolyBuilder builder = EmptyPolyBuilder();
+        PolyBuilderAppend(&builder, &p, 1);
+        p = PolyBuilderFinish(&builder);
+    }
+    return p;
+}
+
+/**
+ * Tworzy pełne drzewo
+ * @param depth : głębokość drzewa
+ * @param width : liczba jednomianów w każdym wielomianie
+ * @return wielomian
+ */
+static Poly MakeTree(unsigned depth, unsigned width) {
+    if (depth == 0) {
+        return PolyFromCoeff(1);
+    }
+    PolyBuilder builder = EmptyPolyBuilder();
+    for (unsigned i = 0; i < width; i++) {
+        Poly t = MakeTree(depth - 1, width);
+        PolyBuilderAppend(&builder, &t, (poly_exp_t) i + 1);
+    }
+    return PolyBuilderFinish(&builder);
+}
+
+/**
+ * Mierzy i wypisuje czasy operacji na wielomianie
+ * @param name : nazwa przypadku
+ * @param p : wskaźnik na wielomian (usuwany przez funkcję)
+ * @param var_idx : indeks zmiennej dla PolyDegBy()
+ */
+static void Measure(const char *name, Poly *p, unsigned var_idx) {
+    double start = Now();
+    Poly q = PolyClone(p);
+    double clone = Now() - start;
+
+    start = Now();
+    bool eq = PolyIsEq(p, &q);
+    double is_eq = Now() - start;
+
+    start = Now();
+    poly_exp_t deg = PolyDeg(p);
+    double deg_time = Now() - start;
+
+    start = Now();
+    poly_exp_t deg_by = PolyDegBy(p, var_idx);
+    double deg_by_time = Now() - start;
+
+    start = Now();
+    PolyDestroy(&q);
+    PolyDestroy(p);
+    double destroy = Now() - start;
+
+    printf("%s: deg %d, deg_by(%u) %d, eq %d\n", name, deg, var_idx, deg_by,
+           eq);
+    printf("  PolyClone   %.6f s\n", clone);
+    printf("  PolyIsEq    %.6f s\n", is_eq);
+    printf("  PolyDeg     %.6f s\n", deg_time);
+    printf("  PolyDegBy   %.6f s\n", deg_by_time);
+    printf("  PolyDestroy %.6f s (obu kopii)\n", destroy);
+}
+
+/**
+ * Odczytuje parametr z linii poleceń
+ * @param argc : liczba argumentów
+ * @param argv : argumenty
+ * @param i : numer parametru
+ * @param def : wartość domyślna
+ * @return wartość parametru
+ */
+static unsigned Arg(int argc, char *argv[], int i, unsigned def) {
+    return i < argc ? (unsigned) strtoul(argv[i], NULL, 10) : def;
+}
+
+/**
+ * Główna funkcja programu
+ * @param argc : liczba argumentów
+ * @param argv : argumenty
+ * @return 0
+ */
+int main(int argc, char *argv[]) {
+    unsigned chain_depth = Arg(argc, argv, 1, DEFAULT_CHAIN_DEPTH);
+    unsigned tree_depth = Arg(argc, argv, 2, DEFAULT_TREE_DEPTH);
+    unsigned tree_width = Arg(argc, argv, 3, DEFAULT_TREE_WIDTH);
+
+    Poly chain = MakeChain(chain_depth);
+    Measure("chain", &chain, chain_depth > 0 ? chain_depth - 1 : 0);
+
+    Poly tree = MakeTree(tree_depth, tree_width);
+    Measure("tree", &tree, tree_depth > 0 ? tree_depth - 1 : 0);
+    return 0;
+}
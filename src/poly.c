@@ -1,7 +1,91 @@
+#include <assert.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include "poly.h"
 
+/**
+ * Liczba elementów stosu roboczego mieszczących się bez alokacji pamięci
+ */
+#define WORK_STACK_INLINE_SIZE 32
+
+/**
+ * Struktura elementu stosu roboczego używanego przez iteracyjne
+ * przechodzenie wielomianów; znaczenie pól zależy od algorytmu
+ */
+typedef struct WorkItem {
+    const Poly *p; ///< przetwarzany wielomian
+    const Poly *q; ///< drugi przetwarzany wielomian
+    Poly *res; ///< miejsce na wynik
+    Mono *mono; ///< przetwarzana lista jednomianów
+    poly_exp_t n; ///< wykładnik lub indeks zmiennej
+} WorkItem;
+
+/**
+ * Struktura stosu roboczego.
+ * Pierwsze elementy są przechowywane w samej strukturze, dopiero głębsze
+ * przejścia alokują (i ponownie wykorzystują) tablicę na stercie.
+ */
+typedef struct WorkStack {
+    WorkItem *items; ///< elementy stosu
+    unsigned int count; ///< liczba elementów na stosie
+    unsigned int size; ///< rozmiar tablicy @p items
+    WorkItem inline_items[WORK_STACK_INLINE_SIZE]; ///< początkowa tablica
+} WorkStack;
+
+/**
+ * Inicjalizuje pusty stos roboczy
+ * @param s : wskaźnik na stos
+ */
+static inline void WorkStackInit(WorkStack *s) {
+    s->items = s->inline_items;
+    s->count = 0;
+    s->size = WORK_STACK_INLINE_SIZE;
+}
+
+/**
+ * Wstawia element na stos roboczy
+ * @param s : wskaźnik na stos
+ * @param item : element
+ */
+static inline void WorkStackPush(WorkStack *s, WorkItem item) {
+    if (s->count == s->size) {
+        s->size *= 2;
+        if (s->items == s->inline_items) {
+            s->items = malloc(s->size * sizeof(WorkItem));
+            memcpy(s->items, s->inline_items, sizeof(s->inline_items));
+        }
+        else {
+            s->items = realloc(s->items, s->size * sizeof(WorkItem));
+        }
+    }
+    s->items[s->count++] = item;
+}
+
+/**
+ * Zdejmuje element ze stosu roboczego
+ * @param s : wskaźnik na stos
+ * @param item : miejsce na zdjęty element
+ * @return czy stos był niepusty?
+ */
+static inline bool WorkStackPop(WorkStack *s, WorkItem *item) {
+    if (s->count == 0) {
+        return false;
+    }
+    *item = s->items[--s->count];
+    return true;
+}
+
+/**
+ * Zwalnia pamięć stosu roboczego
+ * @param s : wskaźnik na stos
+ */
+static inline void WorkStackDestroy(WorkStack *s) {
+    if (s->items != s->inline_items) {
+        free(s->items);
+    }
+}
+
 /**
  * Zwraca większą z dwóch liczb
  * @param a
@@ -31,17 +115,132 @@ poly_coeff_t ipow(poly_coeff_t x, poly_exp_t exp) {
 }
 
 /**
- * Tworzy kopię jednomianu i zwraca wskaźnik na nią.
- * Zwracany wskaźnik jest tworzony za pomocą funkcji @p malloc() i może
- * być bezpiecznie usunięty z pamięci przy użyciu @p free().
- * @param m : Jednomian
- * @return Wskaźnik na kopię jednomianu
+ * Zwraca liczbę jednomianów wielomianu (bez jednomianów współczynników)
+ * @param p : wskaźnik na wielomian
+ * @return liczba jednomianów
+ */
+int PolyLen(const Poly *p) {
+    int count = 0;
+    for (Mono *p_head = p->head; p_head != NULL; p_head = p_head->next) {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * Zwraca liczbę jednomianów wielomianu razem z jednomianami współczynników
+ * @param p : wskaźnik na wielomian
+ * @return liczba jednomianów
+ */
+size_t PolyTermCount(const Poly *p) {
+    size_t count = 0;
+    for (Mono *p_head = p->head; p_head != NULL; p_head = p_head->next) {
+        count += 1 + PolyTermCount(&p_head->p);
+    }
+    return count;
+}
+
+/**
+ * Zwraca listę jednomianów wielomianu, traktując niezerową stałą `c`
+ * jako jednomian `c * x^0`.
+ * @param p : wskaźnik na wielomian
+ * @param tmp : miejsce na jednomian reprezentujący stałą
+ * @return pierwszy jednomian (NULL dla wielomianu zerowego)
+ */
+const Mono *PolyTerms(const Poly *p, Mono *tmp) {
+    if (!PolyIsCoeff(p)) {
+        return p->head;
+    }
+    if (p->coeff == 0) {
+        return NULL;
+    }
+    *tmp = (Mono) {.p = *p, .exp = 0, .next = NULL};
+    return tmp;
+}
+
+/**
+ * Struktura dynamicznie powiększanej tablicy jednomianów
  */
-Mono *MonoMemCopy(const Mono m) {
-    Mono *res = malloc(sizeof(Mono));
-    res->exp = m.exp;
-    res->p = PolyClone(&m.p);
-    res->next = NULL;
+typedef struct MonoBuffer {
+    Mono *monos; ///< jednomiany
+    unsigned int count; ///< liczba jednomianów
+    unsigned int size; ///< rozmiar tablicy @p monos
+} MonoBuffer;
+
+/**
+ * Przenosi jednomiany wielomianu do tablicy, przejmując je na własność.
+ * Niezerowa stała `c` jest przenoszona jako jednomian `c * x^0`.
+ * @param buf : wskaźnik na tablicę jednomianów
+ * @param p : wskaźnik na wielomian (po wywołaniu jest zerowy)
+ */
+static void MonoBufferTake(MonoBuffer *buf, Poly *p) {
+    if (PolyIsZero(p)) {
+        return;
+    }
+    unsigned int needed = buf->count + (PolyIsCoeff(p) ? 1 : PolyLen(p));
+    if (needed > buf->size) {
+        while (buf->size < needed) {
+            buf->size = buf->size == 0 ? 8 : 2 * buf->size;
+        }
+        buf->monos = realloc(buf->monos, buf->size * sizeof(Mono));
+    }
+    if (PolyIsCoeff(p)) {
+        buf->monos[buf->count++] = MonoFromPoly(p, 0);
+    }
+    Mono *p_head = p->head;
+    while (p_head != NULL) {
+        Mono *temp = p_head->next;
+        buf->monos[buf->count++] = *p_head;
+        free(p_head);
+        p_head = temp;
+    }
+    *p = PolyZero();
+}
+
+void PolyBuilderAppend(PolyBuilder *b, Poly *p, poly_exp_t e) {
+    if (PolyIsZero(p)) {
+        return;
+    }
+    Mono *m = malloc(sizeof(Mono));
+    m->p = *p;
+    m->exp = e;
+    PolyBuilderAppendMono(b, m);
+}
+
+void PolyBuilderAppendMono(PolyBuilder *b, Mono *m) {
+    if (PolyIsZero(&m->p)) {
+        free(m);
+        return;
+    }
+    m->next = NULL;
+    if (b->head == NULL) {
+        b->head = m;
+    }
+    else {
+        b->last->next = m;
+    }
+    b->last = m;
+}
+
+/**
+ * Zamienia wielomian postaci `c * x^0` na stałą `c`
+ * @param p : wskaźnik na wielomian o niepustej liście jednomianów
+ */
+static inline void PolyCollapseConst(Poly *p) {
+    Mono *head = p->head;
+    if (head->exp == 0 && head->next == NULL && PolyIsCoeff(&head->p)) {
+        *p = PolyFromCoeff(head->p.coeff);
+        free(head);
+    }
+}
+
+Poly PolyBuilderFinish(PolyBuilder *b) {
+    if (b->head == NULL) {
+        return PolyZero();
+    }
+    Poly res = (Poly) {.head = b->head, .coeff = 0};
+    *b = EmptyPolyBuilder();
+    PolyCollapseConst(&res);
     return res;
 }
 
@@ -93,12 +292,6 @@ void PolyNormalize(Poly *p) {
     }
 }
 
-/**
- * Tworzy kopię wielomianu pomnożoną przez stałą
- * @param p : wskaźnik na wielomian
- * @param c : stała
- * @return c * p
- */
 Poly PolyCloneTimesC(const Poly *p, poly_coeff_t c) {
     if (c == 0) {
         return PolyZero();
@@ -106,37 +299,65 @@ Poly PolyCloneTimesC(const Poly *p, poly_coeff_t c) {
     if (PolyIsCoeff(p)) {
         return PolyFromCoeff(p->coeff * c);
     }
-    Mono *res_head = malloc(sizeof(Mono));
-    Mono *res_last = res_head;
-    Mono *p_head = p->head;
-
-    res_last->p = PolyCloneTimesC(&p_head->p, c);
-    res_last->exp = p_head->exp;
-    p_head = p_head->next;
-
-    Mono *m;
-    while (p_head != NULL) {
-        m = malloc(sizeof(Mono));
-        m->p = PolyCloneTimesC(&p_head->p, c);
-        m->exp = p_head->exp;
-        res_last->next = m;
-        res_last = res_last->next;
-        p_head = p_head->next;
+    Poly res;
+    WorkStack stack;
+    WorkStackInit(&stack);
+    WorkItem item = {.p = p, .res = &res};
+    WorkStackPush(&stack, item);
+    while (WorkStackPop(&stack, &item)) {
+        // item.p nie jest stały; współczynniki stałe kopiujemy od razu,
+        // a pozostałe odkładamy na stos
+        Mono **res_last = &item.res->head;
+        item.res->coeff = 0;
+        for (Mono *p_head = item.p->head; p_head != NULL;
+             p_head = p_head->next) {
+            Mono *m = malloc(sizeof(Mono));
+            m->exp = p_head->exp;
+            if (PolyIsCoeff(&p_head->p)) {
+                m->p = PolyFromCoeff(p_head->p.coeff * c);
+            }
+            else {
+                WorkStackPush(&stack, (WorkItem) {.p = &p_head->p,
+                                                  .res = &m->p});
+            }
+            *res_last = m;
+            res_last = &m->next;
+        }
+        *res_last = NULL;
     }
-    res_last->next = NULL;
-    return (Poly) {.head = res_head, .coeff = 0};
+    WorkStackDestroy(&stack);
+    return res;
 }
 
 void PolyMulByConstant(Poly *p, poly_coeff_t c) {
     if (PolyIsCoeff(p)) {
         p->coeff *= c;
+        return;
     }
-    Mono *head = p->head;
-    while (head != NULL) {
-        PolyMulByConstant(&head->p, c);
-        head = head->next;
+    if (c == 0) {
+        PolyDestroy(p);
+        *p = PolyZero();
+        return;
+    }
+    // jednomiany, które się wyzerowały, od razu usuwamy z listy
+    Mono **link = &p->head;
+    while (*link != NULL) {
+        Mono *m = *link;
+        PolyMulByConstant(&m->p, c);
+        if (PolyIsZero(&m->p)) {
+            *link = m->next;
+            free(m);
+        }
+        else {
+            link = &m->next;
+        }
+    }
+    if (p->head == NULL) {
+        *p = PolyZero();
+    }
+    else {
+        PolyCollapseConst(p);
     }
-    PolyNormalize(p);
 }
 
 void AppendPoly(Poly *p, Poly *q, poly_exp_t e) {
@@ -188,111 +409,77 @@ void AppendPoly(Poly *p, Poly *q, poly_exp_t e) {
 
 void PolyDestroy(Poly *p) {
     Mono *p_head = p->head;
-    while (p_head != NULL) {
-        Mono *temp = p_head->next;
-        PolyDestroy(&p_head->p);
-        free(p_head);
-        p_head = temp;
+    if (p_head == NULL) {
+        return;
     }
+    WorkStack stack;
+    WorkStackInit(&stack);
+    WorkItem item;
+    for (;;) {
+        // zwalniamy bieżącą listę, odkładając listy współczynników na stos
+        while (p_head != NULL) {
+            Mono *temp = p_head->next;
+            if (p_head->p.head != NULL) {
+                WorkStackPush(&stack, (WorkItem) {.mono = p_head->p.head});
+            }
+            free(p_head);
+            p_head = temp;
+        }
+        if (!WorkStackPop(&stack, &item)) {
+            break;
+        }
+        p_head = item.mono;
+    }
+    WorkStackDestroy(&stack);
 }
 
 Poly PolyClone(const Poly *p) {
     return PolyCloneTimesC(p, 1);
 }
 
-Poly PolyAdd(const Poly *p, const Poly *q) {
-    bool pIsCoeff = PolyIsCoeff(p);
-    bool qIsCoeff = PolyIsCoeff(q);
-    if (pIsCoeff && qIsCoeff) {
-        return PolyFromCoeff(p->coeff + q->coeff);
-    }
-    else if (pIsCoeff) {
-        Mono *res_head = malloc(sizeof(Mono));
-        Mono *res_last = res_head;
-        Mono *q_head = q->head;
-        res_last->exp = 0;
-        if (q_head->exp == 0) {
-            res_last->p = PolyAdd(p, &(q_head->p));
-            q_head = q_head->next;
-        }
-        else {
-            res_last->p = PolyFromCoeff(p->coeff);
-        }
-        while (q_head != NULL) {
-            Mono *m = MonoMemCopy(*q_head);
-            res_last->next = m;
-            res_last = res_last->next;
-            q_head = q_head->next;
-        }
-        res_last->next = NULL;
-        Poly res = (Poly) {.head = res_head, .coeff = 0};
-        PolyNormalize(&res);
-        return res;
-    }
-    else if (qIsCoeff) {
-        return PolyAdd(q, p);
+/**
+ * Dodaje do wielomianu wielomian pomnożony przez stałą
+ * (w jednym przejściu po obu listach jednomianów)
+ * @param p : wskaźnik na wielomian
+ * @param q : wskaźnik na wielomian
+ * @param c : stała
+ * @return p + c * q
+ */
+static Poly PolyAddTimesC(const Poly *p, const Poly *q, poly_coeff_t c) {
+    if (PolyIsCoeff(p) && PolyIsCoeff(q)) {
+        return PolyFromCoeff(p->coeff + c * q->coeff);
     }
-    else {
-        Mono *res_head = malloc(sizeof(Mono));
-        Mono *res_last = res_head;
-        Mono *p_head = p->head;
-        Mono *q_head = q->head;
-
-        if (p_head->exp == q_head->exp) {
-            res_last->exp = p_head->exp;
-            res_last->p = PolyAdd(&p_head->p, &q_head->p);
+    Mono p_tmp, q_tmp;
+    const Mono *p_head = PolyTerms(p, &p_tmp);
+    const Mono *q_head = PolyTerms(q, &q_tmp);
+    PolyBuilder builder = EmptyPolyBuilder();
+    while (p_head != NULL || q_head != NULL) {
+        poly_exp_t e;
+        Poly t;
+        if (p_head != NULL && q_head != NULL && p_head->exp == q_head->exp) {
+            e = p_head->exp;
+            t = PolyAddTimesC(&p_head->p, &q_head->p, c);
             p_head = p_head->next;
             q_head = q_head->next;
         }
-        else if (p_head->exp < q_head->exp) {
-            res_last->p = PolyClone(&p_head->p);
-            res_last->exp = p_head->exp;
+        else if (q_head == NULL ||
+                 (p_head != NULL && p_head->exp < q_head->exp)) {
+            e = p_head->exp;
+            t = PolyClone(&p_head->p);
             p_head = p_head->next;
         }
         else {
-            res_last->p = PolyClone(&q_head->p);
-            res_last->exp = q_head->exp;
-            q_head = q_head->next;
-        }
-
-        while (p_head != NULL && q_head != NULL) {
-            Mono *m = malloc(sizeof(Mono));
-            if (p_head->exp == q_head->exp) {
-                m->exp = p_head->exp;
-                m->p = PolyAdd(&(p_head->p), &(q_head->p));
-                p_head = p_head->next;
-                q_head = q_head->next;
-            }
-            else if (p_head->exp < q_head->exp) {
-                m->exp = p_head->exp;
-                m->p = PolyClone(&p_head->p);
-                p_head = p_head->next;
-            }
-            else {
-                m->exp = q_head->exp;
-                m->p = PolyClone(&q_head->p);
-                q_head = q_head->next;
-            }
-            res_last->next = m;
-            res_last = res_last->next;
-        }
-
-        while (p_head != NULL) {
-            res_last->next = MonoMemCopy(*p_head);
-            res_last = res_last->next;
-            p_head = p_head->next;
-        }
-        while (q_head != NULL) {
-            res_last->next = MonoMemCopy(*q_head);
-            res_last = res_last->next;
+            e = q_head->exp;
+            t = PolyCloneTimesC(&q_head->p, c);
             q_head = q_head->next;
         }
-
-        res_last->next = NULL;
-        Poly res = (Poly) {.coeff = 0, .head = res_head};
-        PolyNormalize(&res);
-        return res;
+        PolyBuilderAppend(&builder, &t, e);
     }
+    return PolyBuilderFinish(&builder);
+}
+
+Poly PolyAdd(const Poly *p, const Poly *q) {
+    return PolyAddTimesC(p, q, 1);
 }
 
 Poly PolyNeg(const Poly *p) {
@@ -300,10 +487,7 @@ Poly PolyNeg(const Poly *p) {
 }
 
 Poly PolySub(const Poly *p, const Poly *q) {
-    Poly minus_q = PolyNeg(q);
-    Poly res = PolyAdd(p, &minus_q);
-    PolyDestroy(&minus_q);
-    return res;
+    return PolyAddTimesC(p, q, -1);
 }
 
 /**
@@ -325,44 +509,29 @@ Poly PolyAddMonos(unsigned count, const Mono monos[]) {
         return PolyZero();
     }
 
-    Mono temp_arr[count];
+    Mono *temp_arr = malloc(count * sizeof(Mono));
     for (unsigned int i = 0; i < count; i++) {
         temp_arr[i] = monos[i];
     }
 
     qsort((void *) temp_arr, count, sizeof(Mono), MonoCmp);
 
-    Mono *res_head = malloc(sizeof(Mono));
-    *res_head = temp_arr[0];
-    Mono *res_last = res_head;
-
-    for (unsigned int i = 1; i < count; i++) {
-        if (res_last->exp == temp_arr[i].exp) {
-            Poly temp = res_last->p;
-            Poly current = temp_arr[i].p;
-            res_last->p = PolyAdd(&temp, &current);
-            PolyDestroy(&temp);
-            PolyDestroy(&current);
-        } else {
-            Mono *m = malloc(sizeof(Mono));
-            *m = temp_arr[i];
-            res_last->next = m;
-            res_last = res_last->next;
+    PolyBuilder builder = EmptyPolyBuilder();
+    unsigned int i = 0;
+    while (i < count) {
+        poly_exp_t e = temp_arr[i].exp;
+        Poly sum = temp_arr[i].p;
+        for (i++; i < count && temp_arr[i].exp == e; i++) {
+            Poly temp = PolyAdd(&sum, &temp_arr[i].p);
+            PolyDestroy(&sum);
+            PolyDestroy(&temp_arr[i].p);
+            sum = temp;
         }
+        PolyBuilderAppend(&builder, &sum, e);
     }
 
-    res_last->next = NULL;
-    Poly res = (Poly) {.head = res_head, .coeff = 0};
-    PolyNormalize(&res);
-    return res;
-}
-
-int PolyLen(const Poly *p) {
-    int count = 0;
-    for (Mono *p_head = p->head; p_head != NULL; p_head = p_head->next) {
-        count++;
-    }
-    return count;
+    free(temp_arr);
+    return PolyBuilderFinish(&builder);
 }
 
 Poly PolyMul(const Poly *p, const Poly *q) {
@@ -398,81 +567,778 @@ Poly PolyMul(const Poly *p, const Poly *q) {
 }
 
 bool PolyIsEq(const Poly *p, const Poly *q) {
-    if (PolyIsCoeff(p)) {
-        return PolyIsCoeff(q) && p->coeff == q->coeff;
-    }
-    Mono *p_head = p->head;
-    Mono *q_head = q->head;
-    while (p_head != NULL && q_head != NULL) {
-        if (p_head->exp != q_head->exp || !PolyIsEq(&p_head->p, &q_head->p)) {
-            return false;
+    WorkStack stack;
+    WorkStackInit(&stack);
+    WorkItem item = {.p = p, .q = q};
+    WorkStackPush(&stack, item);
+    bool res = true;
+    while (res && WorkStackPop(&stack, &item)) {
+        if (PolyIsCoeff(item.p) || PolyIsCoeff(item.q)) {
+            res = PolyIsCoeff(item.p) && PolyIsCoeff(item.q) &&
+                  item.p->coeff == item.q->coeff;
+            continue;
         }
-        p_head = p_head->next;
-        q_head = q_head->next;
+        Mono *p_head = item.p->head;
+        Mono *q_head = item.q->head;
+        while (p_head != NULL && q_head != NULL) {
+            if (p_head->exp != q_head->exp) {
+                break;
+            }
+            WorkStackPush(&stack, (WorkItem) {.p = &p_head->p,
+                                              .q = &q_head->p});
+            p_head = p_head->next;
+            q_head = q_head->next;
+        }
+        res = p_head == NULL && q_head == NULL;
     }
-    return p_head == NULL && q_head == NULL;
+    WorkStackDestroy(&stack);
+    return res;
 }
 
 poly_exp_t PolyDeg(const Poly *p) {
-    if (PolyIsZero(p)) {
-        return -1;
+    WorkStack stack;
+    WorkStackInit(&stack);
+    // n to suma wykładników na ścieżce od korzenia do item.p
+    WorkItem item = {.p = p, .n = 0};
+    WorkStackPush(&stack, item);
+    poly_exp_t res = -1;
+    while (WorkStackPop(&stack, &item)) {
+        if (PolyIsZero(item.p)) {
+            res = max(res, item.n - 1);
+        }
+        else if (PolyIsCoeff(item.p)) {
+            res = max(res, item.n);
+        }
+        else {
+            for (Mono *p_head = item.p->head; p_head != NULL;
+                 p_head = p_head->next) {
+                WorkStackPush(&stack, (WorkItem) {.p = &p_head->p,
+                                                  .n = item.n + p_head->exp});
+            }
+        }
+    }
+    WorkStackDestroy(&stack);
+    return res;
+}
+
+poly_exp_t PolyDegBy(const Poly *p, unsigned var_idx) {
+    WorkStack stack;
+    WorkStackInit(&stack);
+    // n to indeks szukanej zmiennej względem zmiennej głównej item.p
+    WorkItem item = {.p = p, .n = (poly_exp_t) var_idx};
+    WorkStackPush(&stack, item);
+    poly_exp_t res = -1;
+    while (WorkStackPop(&stack, &item)) {
+        if (PolyIsZero(item.p)) {
+            continue;
+        }
+        if (PolyIsCoeff(item.p)) {
+            res = max(res, 0);
+            continue;
+        }
+        Mono *p_head = item.p->head;
+        if (item.n == 0) {
+            while (p_head->next != NULL) {
+                p_head = p_head->next;
+            }
+            res = max(res, p_head->exp);
+            continue;
+        }
+        for (; p_head != NULL; p_head = p_head->next) {
+            WorkStackPush(&stack, (WorkItem) {.p = &p_head->p,
+                                              .n = item.n - 1});
+        }
     }
+    WorkStackDestroy(&stack);
+    return res;
+}
+
+Poly PolyAt(const Poly *p, poly_coeff_t x) {
     if (PolyIsCoeff(p)) {
-        return 0;
+        return PolyFromCoeff(p->coeff);
     }
-    Mono *p_head = p->head;
-    poly_exp_t res = -1;
-    while (p_head != NULL) {
-        res = max(res, p_head->exp + PolyDeg(&p_head->p));
-        p_head = p_head->next;
+    // współczynniki są wielomianami tej samej zmiennej co wynik,
+    // więc ich jednomiany sumujemy jednym wywołaniem PolyAddMonos
+    MonoBuffer buf = {.monos = NULL, .count = 0, .size = 0};
+    for (Mono *p_head = p->head; p_head != NULL; p_head = p_head->next) {
+        Poly t = PolyCloneTimesC(&p_head->p, ipow(x, p_head->exp));
+        MonoBufferTake(&buf, &t);
     }
+    Poly res = PolyAddMonos(buf.count, buf.monos);
+    free(buf.monos);
     return res;
 }
 
-poly_exp_t PolyDegBy(const Poly *p, unsigned var_idx) {
-    if (PolyIsZero(p)) {
-        return -1;
+/**
+ * Sprawdza, czy ograniczenie wyklucza wszystkie jednomiany
+ * (również stałe).
+ * @param b : ograniczenie
+ * @return czy ograniczenie jest puste?
+ */
+static bool BoundIsEmpty(const PolyBound *b) {
+    if (b->total < 0) {
+        return true;
+    }
+    for (unsigned i = 0; i < b->var_count; i++) {
+        if (b->by_var[i] < 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Zwraca największy dopuszczalny wykładnik zmiennej
+ * @param b : ograniczenie
+ * @param rem : niewykorzystana część ograniczenia stopnia całkowitego
+ * @param var_idx : indeks zmiennej
+ * @return największy dopuszczalny wykładnik zmiennej o indeksie @p var_idx
+ */
+static inline poly_exp_t BoundLimit(const PolyBound *b, poly_exp_t rem,
+                                    unsigned var_idx) {
+    if (var_idx < b->var_count && b->by_var[var_idx] < rem) {
+        return b->by_var[var_idx];
     }
+    return rem;
+}
+
+/**
+ * Tworzy obciętą kopię wielomianu pomnożoną przez stałą
+ * @param p : wskaźnik na wielomian zmiennej o indeksie @p var_idx
+ * @param c : stała
+ * @param rem : niewykorzystana część ograniczenia stopnia całkowitego
+ * @param var_idx : indeks zmiennej
+ * @param b : ograniczenie
+ * @return c * p obcięte do ograniczenia
+ */
+static Poly TruncTimesC(const Poly *p, poly_coeff_t c, poly_exp_t rem,
+                        unsigned var_idx, const PolyBound *b) {
     if (PolyIsCoeff(p)) {
-        return 0;
+        return PolyFromCoeff(p->coeff * c);
+    }
+    poly_exp_t lim = BoundLimit(b, rem, var_idx);
+    PolyBuilder builder = EmptyPolyBuilder();
+    for (Mono *m = p->head; m != NULL && m->exp <= lim; m = m->next) {
+        Poly t = TruncTimesC(&m->p, c, rem - m->exp, var_idx + 1, b);
+        PolyBuilderAppend(&builder, &t, m->exp);
     }
-    if (var_idx == 0) {
-        Mono *p_head = p->head;
-        while (p_head->next != NULL) {
+    return PolyBuilderFinish(&builder);
+}
+
+/**
+ * Dodaje dwa wielomiany, pomijając jednomiany spoza ograniczenia
+ * @param p : wskaźnik na wielomian zmiennej o indeksie @p var_idx
+ * @param q : wskaźnik na wielomian zmiennej o indeksie @p var_idx
+ * @param rem : niewykorzystana część ograniczenia stopnia całkowitego
+ * @param var_idx : indeks zmiennej
+ * @param b : ograniczenie
+ * @return p + q obcięte do ograniczenia
+ */
+static Poly AddTrunc(const Poly *p, const Poly *q, poly_exp_t rem,
+                     unsigned var_idx, const PolyBound *b) {
+    if (PolyIsCoeff(p) && PolyIsCoeff(q)) {
+        return PolyFromCoeff(p->coeff + q->coeff);
+    }
+    poly_exp_t lim = BoundLimit(b, rem, var_idx);
+    Mono p_tmp, q_tmp;
+    const Mono *p_head = PolyTerms(p, &p_tmp);
+    const Mono *q_head = PolyTerms(q, &q_tmp);
+    PolyBuilder builder = EmptyPolyBuilder();
+    for (;;) {
+        bool p_fits = p_head != NULL && p_head->exp <= lim;
+        bool q_fits = q_head != NULL && q_head->exp <= lim;
+        poly_exp_t e;
+        Poly t;
+        if (p_fits && q_fits && p_head->exp == q_head->exp) {
+            e = p_head->exp;
+            t = AddTrunc(&p_head->p, &q_head->p, rem - e, var_idx + 1, b);
+            p_head = p_head->next;
+            q_head = q_head->next;
+        }
+        else if (p_fits && (!q_fits || p_head->exp < q_head->exp)) {
+            e = p_head->exp;
+            t = TruncTimesC(&p_head->p, 1, rem - e, var_idx + 1, b);
             p_head = p_head->next;
         }
-        return p_head->exp;
+        else if (q_fits) {
+            e = q_head->exp;
+            t = TruncTimesC(&q_head->p, 1, rem - e, var_idx + 1, b);
+            q_head = q_head->next;
+        }
+        else {
+            break;
+        }
+        PolyBuilderAppend(&builder, &t, e);
     }
+    return PolyBuilderFinish(&builder);
+}
 
-    poly_exp_t res = -1;
-    Mono *p_head = p->head;
-    while (p_head != NULL) {
-        res = max(res, PolyDegBy(&p_head->p, var_idx - 1));
-        p_head = p_head->next;
+/**
+ * Mnoży dwa wielomiany, pomijając iloczyny jednomianów spoza ograniczenia
+ * @param p : wskaźnik na wielomian zmiennej o indeksie @p var_idx
+ * @param q : wskaźnik na wielomian zmiennej o indeksie @p var_idx
+ * @param rem : niewykorzystana część ograniczenia stopnia całkowitego
+ * @param var_idx : indeks zmiennej
+ * @param b : ograniczenie
+ * @return p * q obcięte do ograniczenia
+ */
+static Poly MulTrunc(const Poly *p, const Poly *q, poly_exp_t rem,
+                     unsigned var_idx, const PolyBound *b) {
+    if (PolyIsZero(p) || PolyIsZero(q)) {
+        return PolyZero();
+    }
+    if (PolyIsCoeff(p) && PolyIsCoeff(q)) {
+        return PolyFromCoeff(p->coeff * q->coeff);
+    }
+    if (PolyIsCoeff(p)) {
+        return TruncTimesC(q, p->coeff, rem, var_idx, b);
+    }
+    if (PolyIsCoeff(q)) {
+        return TruncTimesC(p, q->coeff, rem, var_idx, b);
+    }
+    poly_exp_t lim = BoundLimit(b, rem, var_idx);
+    // jednomiany są posortowane rosnąco, więc dla każdego jednomianu p
+    // przeglądamy tylko początkowy fragment listy q
+    unsigned int count = 0;
+    for (Mono *p_head = p->head; p_head != NULL && p_head->exp <= lim;
+         p_head = p_head->next) {
+        for (Mono *q_head = q->head;
+             q_head != NULL && q_head->exp <= lim - p_head->exp;
+             q_head = q_head->next) {
+            count++;
+        }
+    }
+    if (count == 0) {
+        return PolyZero();
+    }
+    Mono *arr = malloc(count * sizeof(Mono));
+    count = 0;
+    for (Mono *p_head = p->head; p_head != NULL && p_head->exp <= lim;
+         p_head = p_head->next) {
+        for (Mono *q_head = q->head;
+             q_head != NULL && q_head->exp <= lim - p_head->exp;
+             q_head = q_head->next) {
+            poly_exp_t e = p_head->exp + q_head->exp;
+            Poly t = MulTrunc(&p_head->p, &q_head->p, rem - e, var_idx + 1, b);
+            if (!PolyIsZero(&t)) {
+                arr[count++] = MonoFromPoly(&t, e);
+            }
+        }
+    }
+    Poly res = PolyAddMonos(count, arr);
+    free(arr);
+    return res;
+}
+
+Poly PolyTrunc(const Poly *p, const PolyBound *bound) {
+    if (BoundIsEmpty(bound)) {
+        return PolyZero();
     }
+    return TruncTimesC(p, 1, bound->total, 0, bound);
+}
 
+Poly PolyAddTrunc(const Poly *p, const Poly *q, const PolyBound *bound) {
+    if (BoundIsEmpty(bound)) {
+        return PolyZero();
+    }
+    return AddTrunc(p, q, bound->total, 0, bound);
+}
+
+Poly PolyMulTrunc(const Poly *p, const Poly *q, const PolyBound *bound) {
+    if (BoundIsEmpty(bound)) {
+        return PolyZero();
+    }
+    return MulTrunc(p, q, bound->total, 0, bound);
+}
+
+Poly PolyPowTrunc(const Poly *p, poly_exp_t n, const PolyBound *bound) {
+    if (BoundIsEmpty(bound)) {
+        return PolyZero();
+    }
+    Poly res = PolyFromCoeff(1);
+    Poly base = PolyTrunc(p, bound);
+    while (n > 0) {
+        if (n & 1) {
+            Poly temp = PolyMulTrunc(&res, &base, bound);
+            PolyDestroy(&res);
+            res = temp;
+        }
+        n >>= 1;
+        if (n > 0) {
+            Poly temp = PolyMulTrunc(&base, &base, bound);
+            PolyDestroy(&base);
+            base = temp;
+        }
+    }
+    PolyDestroy(&base);
     return res;
 }
 
-Poly PolyAt(const Poly *p, poly_coeff_t x) {
+Poly PolyPow(const Poly *p, poly_exp_t n) {
+    Poly res = PolyFromCoeff(1);
+    Poly base = PolyClone(p);
+    while (n > 0) {
+        if (n & 1) {
+            Poly temp = PolyMul(&res, &base);
+            PolyDestroy(&res);
+            res = temp;
+        }
+        n >>= 1;
+        if (n > 0) {
+            Poly temp = PolyMul(&base, &base);
+            PolyDestroy(&base);
+            base = temp;
+        }
+    }
+    PolyDestroy(&base);
+    return res;
+}
+
+/**
+ * Struktura przechowująca tablicę potęg wielomianu dla posortowanego
+ * zbioru wykładników
+ */
+typedef struct PowTable {
+    poly_exp_t *exps; ///< rosnący ciąg różnych dodatnich wykładników
+    Poly *pows; ///< `pows[i]` to podstawa podniesiona do potęgi `exps[i]`
+    unsigned int count; ///< liczba wykładników
+    unsigned int size; ///< rozmiar tablicy @p exps
+} PowTable;
+
+/**
+ * Dodaje wykładnik do zbioru wykładników tablicy potęg
+ * @param t : wskaźnik na tablicę potęg
+ * @param e : wykładnik
+ */
+static void PowTableAddExp(PowTable *t, poly_exp_t e) {
+    if (e <= 0) {
+        return;
+    }
+    if (t->count == t->size) {
+        t->size = t->size == 0 ? 8 : 2 * t->size;
+        t->exps = realloc(t->exps, t->size * sizeof(poly_exp_t));
+    }
+    t->exps[t->count++] = e;
+}
+
+/**
+ * Funkcja porównująca dwa wykładniki
+ * @param e1 : wskaźnik na pierwszy wykładnik
+ * @param e2 : wskaźnik na drugi wykładnik
+ * @return -1, 0 lub 1 zależnie od wyniku porównania
+ */
+static int ExpCmp(const void *e1, const void *e2) {
+    poly_exp_t a = *(const poly_exp_t *) e1;
+    poly_exp_t b = *(const poly_exp_t *) e2;
+    return a < b ? -1 : a > b;
+}
+
+/**
+ * Zwraca indeks wykładnika w tablicy potęg
+ * @param t : wskaźnik na tablicę potęg
+ * @param e : wykładnik
+ * @param end : liczba początkowych wykładników, które są przeszukiwane
+ * @return indeks wykładnika @p e lub -1, jeżeli go nie ma
+ */
+static int PowTableFind(const PowTable *t, poly_exp_t e, unsigned int end) {
+    unsigned int lo = 0, hi = end;
+    while (lo < hi) {
+        unsigned int mid = lo + (hi - lo) / 2;
+        if (t->exps[mid] < e) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo < end && t->exps[lo] == e ? (int) lo : -1;
+}
+
+/**
+ * Wylicza potęgi wielomianu dla wszystkich wykładników tablicy.
+ * Kolejne potęgi powstają z poprzednich przez domnożenie potęgi różnicy
+ * wykładników, która w miarę możliwości też jest brana z tablicy.
+ * @param t : wskaźnik na tablicę potęg
+ * @param base : wskaźnik na podstawę
+ */
+static void PowTableFill(PowTable *t, const Poly *base) {
+    if (t->count == 0) {
+        return;
+    }
+    qsort(t->exps, t->count, sizeof(poly_exp_t), ExpCmp);
+    unsigned int unique = 1;
+    for (unsigned int i = 1; i < t->count; i++) {
+        if (t->exps[i] != t->exps[unique - 1]) {
+            t->exps[unique++] = t->exps[i];
+        }
+    }
+    t->count = unique;
+    t->pows = malloc(t->count * sizeof(Poly));
+    t->pows[0] = PolyPow(base, t->exps[0]);
+    for (unsigned int i = 1; i < t->count; i++) {
+        poly_exp_t diff = t->exps[i] - t->exps[i - 1];
+        int j = PowTableFind(t, diff, i);
+        if (j >= 0) {
+            t->pows[i] = PolyMul(&t->pows[i - 1], &t->pows[j]);
+        }
+        else {
+            Poly step = PolyPow(base, diff);
+            t->pows[i] = PolyMul(&t->pows[i - 1], &step);
+            PolyDestroy(&step);
+        }
+    }
+}
+
+/**
+ * Usuwa tablicę potęg z pamięci
+ * @param t : wskaźnik na tablicę potęg
+ */
+static void PowTableDestroy(PowTable *t) {
+    if (t->pows != NULL) {
+        for (unsigned int i = 0; i < t->count; i++) {
+            PolyDestroy(&t->pows[i]);
+        }
+    }
+    free(t->pows);
+    free(t->exps);
+}
+
+/**
+ * Zbiera wykładniki potrzebne do złożenia wielomianu schematem Hornera:
+ * najmniejszy wykładnik oraz różnice kolejnych wykładników
+ * @param p : wskaźnik na wielomian zmiennej o indeksie @p var_idx
+ * @param var_idx : indeks zmiennej
+ * @param k : liczba podstawianych wielomianów
+ * @param tables : tablice potęg kolejnych zmiennych
+ */
+static void ComposePlan(const Poly *p, unsigned var_idx, unsigned k,
+                        PowTable tables[]) {
+    if (PolyIsCoeff(p)) {
+        return;
+    }
+    if (var_idx >= k) {
+        if (p->head->exp == 0) {
+            ComposePlan(&p->head->p, var_idx + 1, k, tables);
+        }
+        return;
+    }
+    poly_exp_t prev = 0;
+    for (Mono *p_head = p->head; p_head != NULL; p_head = p_head->next) {
+        PowTableAddExp(&tables[var_idx], p_head->exp - prev);
+        prev = p_head->exp;
+        ComposePlan(&p_head->p, var_idx + 1, k, tables);
+    }
+}
+
+/**
+ * Zwraca potęgę z tablicy potęg
+ * @param t : wskaźnik na tablicę potęg
+ * @param e : dodatni wykładnik obecny w tablicy
+ * @return wskaźnik na potęgę
+ */
+static const Poly *PowTableGet(const PowTable *t, poly_exp_t e) {
+    int i = PowTableFind(t, e, t->count);
+    assert(i >= 0);
+    return &t->pows[i];
+}
+
+/**
+ * Składa wielomian z wielomianami, których potęgi są w tablicach
+ * @param p : wskaźnik na wielomian zmiennej o indeksie @p var_idx
+ * @param var_idx : indeks zmiennej
+ * @param k : liczba podstawianych wielomianów
+ * @param tables : wypełnione tablice potęg kolejnych zmiennych
+ * @return złożenie
+ */
+static Poly ComposeRec(const Poly *p, unsigned var_idx, unsigned k,
+                       const PowTable tables[]) {
     if (PolyIsCoeff(p)) {
         return PolyFromCoeff(p->coeff);
     }
-    Poly res = PolyZero();
+    if (var_idx >= k) {
+        if (p->head->exp == 0) {
+            return ComposeRec(&p->head->p, var_idx + 1, k, tables);
+        }
+        return PolyZero();
+    }
+    int len = PolyLen(p);
+    const Mono **terms = malloc(len * sizeof(Mono *));
+    int i = 0;
     for (Mono *p_head = p->head; p_head != NULL; p_head = p_head->next) {
-        poly_coeff_t e = ipow(x, p_head->exp);
-        Poly t = p_head->p;
-        if (PolyIsCoeff(&t)) {
-            Poly w = PolyFromCoeff(t.coeff * e);
-            AppendPoly(&res, &w, 0);
-        } else {
-            for (Mono *t_head = t.head; t_head != NULL; t_head = t_head->next) {
-                poly_coeff_t new_e = t_head->exp;
-                Poly w = PolyCloneTimesC(&t_head->p, e);
-                AppendPoly(&res, &w, new_e);
-            }
+        terms[i++] = p_head;
+    }
+    const PowTable *t = &tables[var_idx];
+    Poly res = ComposeRec(&terms[len - 1]->p, var_idx + 1, k, tables);
+    for (i = len - 2; i >= 0; i--) {
+        poly_exp_t diff = terms[i + 1]->exp - terms[i]->exp;
+        Poly shifted = PolyMul(&res, PowTableGet(t, diff));
+        Poly coeff = ComposeRec(&terms[i]->p, var_idx + 1, k, tables);
+        PolyDestroy(&res);
+        res = PolyAdd(&shifted, &coeff);
+        PolyDestroy(&shifted);
+        PolyDestroy(&coeff);
+    }
+    if (terms[0]->exp > 0) {
+        Poly shifted = PolyMul(&res, PowTableGet(t, terms[0]->exp));
+        PolyDestroy(&res);
+        res = shifted;
+    }
+    free(terms);
+    return res;
+}
+
+Poly PolyCompose(const Poly *p, unsigned k, const Poly q[]) {
+    PowTable *tables = calloc(k == 0 ? 1 : k, sizeof(PowTable));
+    ComposePlan(p, 0, k, tables);
+    for (unsigned i = 0; i < k; i++) {
+        PowTableFill(&tables[i], &q[i]);
+    }
+    Poly res = ComposeRec(p, 0, k, tables);
+    for (unsigned i = 0; i < k; i++) {
+        PowTableDestroy(&tables[i]);
+    }
+    free(tables);
+    return res;
+}
+
+/**
+ * Funkcja porównująca dwa podstawienia według indeksów zmiennych
+ * @param v1 : wskaźnik na pierwsze podstawienie
+ * @param v2 : wskaźnik na drugie podstawienie
+ * @return -1, 0 lub 1 zależnie od wyniku porównania indeksów
+ */
+static int VarValueCmp(const void *v1, const void *v2) {
+    unsigned a = ((const PolyVarValue *) v1)->var_idx;
+    unsigned b = ((const PolyVarValue *) v2)->var_idx;
+    return a < b ? -1 : a > b;
+}
+
+/**
+ * Zbiera wykładniki podstawianych zmiennych
+ * @param p : wskaźnik na wielomian zmiennej o indeksie @p var_idx
+ * @param var_idx : indeks zmiennej
+ * @param values : podstawienia posortowane według indeksów zmiennych
+ * @param pos : indeks pierwszego podstawienia zmiennej >= @p var_idx
+ * @param count : liczba podstawień
+ * @param tables : tablice potęg kolejnych podstawianych wartości
+ */
+static void AtVarsPlan(const Poly *p, unsigned var_idx,
+                       const PolyVarValue values[], unsigned pos,
+                       unsigned count, PowTable tables[]) {
+    if (PolyIsCoeff(p) || pos == count) {
+        return;
+    }
+    bool substituted = values[pos].var_idx == var_idx;
+    unsigned next_pos = substituted ? pos + 1 : pos;
+    for (Mono *p_head = p->head; p_head != NULL; p_head = p_head->next) {
+        if (substituted) {
+            PowTableAddExp(&tables[pos], p_head->exp);
         }
+        AtVarsPlan(&p_head->p, var_idx + 1, values, next_pos, count, tables);
+    }
+}
+
+/**
+ * Podstawia wartości pod zmienne wielomianu
+ * @param p : wskaźnik na wielomian zmiennej o indeksie @p var_idx
+ * @param var_idx : indeks zmiennej
+ * @param values : podstawienia posortowane według indeksów zmiennych
+ * @param pos : indeks pierwszego podstawienia zmiennej >= @p var_idx
+ * @param count : liczba podstawień
+ * @param tables : wypełnione tablice potęg kolejnych podstawianych wartości
+ * @return wielomian po podstawieniu
+ */
+static Poly AtVarsRec(const Poly *p, unsigned var_idx,
+                      const PolyVarValue values[], unsigned pos,
+                      unsigned count, const PowTable tables[]) {
+    if (PolyIsCoeff(p)) {
+        return PolyFromCoeff(p->coeff);
     }
-    PolyNormalize(&res);
+    if (pos == count) {
+        return PolyClone(p);
+    }
+    if (values[pos].var_idx != var_idx) {
+        PolyBuilder builder = EmptyPolyBuilder();
+        for (Mono *p_head = p->head; p_head != NULL; p_head = p_head->next) {
+            Poly t = AtVarsRec(&p_head->p, var_idx + 1, values, pos, count,
+                               tables);
+            PolyBuilderAppend(&builder, &t, p_head->exp);
+        }
+        return PolyBuilderFinish(&builder);
+    }
+    // współczynniki są wielomianami tej samej zmiennej co wynik,
+    // więc ich jednomiany sumujemy jednym wywołaniem PolyAddMonos
+    MonoBuffer buf = {.monos = NULL, .count = 0, .size = 0};
+    for (Mono *p_head = p->head; p_head != NULL; p_head = p_head->next) {
+        Poly t = AtVarsRec(&p_head->p, var_idx + 1, values, pos + 1, count,
+                           tables);
+        if (p_head->exp > 0) {
+            PolyMulByConstant(&t, PowTableGet(&tables[pos], p_head->exp)->coeff);
+        }
+        MonoBufferTake(&buf, &t);
+    }
+    Poly res = PolyAddMonos(buf.count, buf.monos);
+    free(buf.monos);
+    return res;
+}
+
+Poly PolyAtVars(const Poly *p, unsigned count, const PolyVarValue values[]) {
+    if (count == 0) {
+        return PolyClone(p);
+    }
+    PolyVarValue *sorted = malloc(count * sizeof(PolyVarValue));
+    for (unsigned i = 0; i < count; i++) {
+        sorted[i] = values[i];
+    }
+    qsort(sorted, count, sizeof(PolyVarValue), VarValueCmp);
+    PowTable *tables = calloc(count, sizeof(PowTable));
+    AtVarsPlan(p, 0, sorted, 0, count, tables);
+    for (unsigned i = 0; i < count; i++) {
+        Poly base = PolyFromCoeff(sorted[i].value);
+        PowTableFill(&tables[i], &base);
+    }
+    Poly res = AtVarsRec(p, 0, sorted, 0, count, tables);
+    for (unsigned i = 0; i < count; i++) {
+        PowTableDestroy(&tables[i]);
+    }
+    free(tables);
+    free(sorted);
     return res;
 }
+
+Poly PolyDerive(const Poly *p, unsigned var_idx) {
+    if (PolyIsCoeff(p)) {
+        return PolyZero();
+    }
+    PolyBuilder builder = EmptyPolyBuilder();
+    for (Mono *p_head = p->head; p_head != NULL; p_head = p_head->next) {
+        Poly t;
+        poly_exp_t e = p_head->exp;
+        if (var_idx > 0) {
+            t = PolyDerive(&p_head->p, var_idx - 1);
+        }
+        else if (e > 0) {
+            t = PolyCloneTimesC(&p_head->p, e);
+            e--;
+        }
+        else {
+            continue;
+        }
+        PolyBuilderAppend(&builder, &t, e);
+    }
+    return PolyBuilderFinish(&builder);
+}
+
+/**
+ * Zwraca liczbę poziomów zagnieżdżenia wielomianu (0 dla stałej)
+ * @param p : wskaźnik na wielomian
+ * @return głębokość wielomianu
+ */
+static unsigned PolyDepth(const Poly *p) {
+    unsigned depth = 0;
+    if (!PolyIsCoeff(p)) {
+        for (Mono *p_head = p->head; p_head != NULL; p_head = p_head->next) {
+            unsigned d = PolyDepth(&p_head->p);
+            if (d > depth) {
+                depth = d;
+            }
+        }
+        depth++;
+    }
+    return depth;
+}
+
+/**
+ * Wylicza wartości i pochodne cząstkowe wielomianu we wszystkich punktach
+ * partii jednym przejściem po wielomianie (arytmetyka liczb dualnych).
+ * Gradient punktu jest wierszem długości `n - var_idx` (0, gdy
+ * `var_idx >= n`), którego `i`-ty element jest pochodną względem zmiennej
+ * o indeksie `var_idx + i`.
+ * @param p : wskaźnik na wielomian zmiennej o indeksie @p var_idx
+ * @param var_idx : indeks zmiennej
+ * @param n : wymiar punktów
+ * @param count : liczba punktów
+ * @param points : współrzędne punktów (wierszami długości @p n)
+ * @param values : tablica długości @p count na wartości
+ * @param grads : tablica na gradienty (@p count wierszy)
+ * @param scratch : pamięć pomocnicza; poziom o indeksie `d < n` zajmuje
+ *                  `count * (n - d + 1)` liczb
+ */
+static void EvalGradBatchRec(const Poly *p, unsigned var_idx, unsigned n,
+                             unsigned count, const poly_coeff_t points[],
+                             poly_coeff_t values[], poly_coeff_t grads[],
+                             poly_coeff_t *scratch) {
+    size_t width = var_idx < n ? n - var_idx : 0;
+    for (size_t j = 0; j < count * width; j++) {
+        grads[j] = 0;
+    }
+    if (PolyIsCoeff(p) || var_idx >= n) {
+        for (unsigned j = 0; j < count; j++) {
+            values[j] = PolyIsCoeff(p) ? p->coeff : 0;
+        }
+        if (!PolyIsCoeff(p) && p->head->exp == 0) {
+            EvalGradBatchRec(&p->head->p, var_idx + 1, n, count, points,
+                             values, grads, scratch);
+        }
+        return;
+    }
+
+    size_t child_width = width - 1;
+    poly_coeff_t *child_values = scratch;
+    poly_coeff_t *child_grads = child_values + count;
+    // x^(e - 1) dla wykładnika poprzedniego jednomianu, osobno dla punktów
+    poly_coeff_t *pow_prev = child_grads + count * child_width;
+    poly_coeff_t *next_scratch = pow_prev + count;
+    for (unsigned j = 0; j < count; j++) {
+        values[j] = 0;
+        pow_prev[j] = 1;
+    }
+    poly_exp_t pow_prev_exp = 0;
+    for (Mono *p_head = p->head; p_head != NULL; p_head = p_head->next) {
+        poly_exp_t e = p_head->exp;
+        EvalGradBatchRec(&p_head->p, var_idx + 1, n, count, points,
+                         child_values, child_grads, next_scratch);
+        for (unsigned j = 0; j < count; j++) {
+            poly_coeff_t c = child_values[j];
+            poly_coeff_t *grad = grads + j * width;
+            const poly_coeff_t *child_grad = child_grads + j * child_width;
+            poly_coeff_t pow = 1;
+            if (e > 0) {
+                poly_coeff_t x = points[(size_t) j * n + var_idx];
+                pow_prev[j] *= ipow(x, e - 1 - pow_prev_exp);
+                pow = pow_prev[j] * x;
+                grad[0] += e * c * pow_prev[j];
+            }
+            values[j] += c * pow;
+            for (size_t i = 0; i < child_width; i++) {
+                grad[i + 1] += child_grad[i] * pow;
+            }
+        }
+        if (e > 0) {
+            pow_prev_exp = e - 1;
+        }
+    }
+}
+
+poly_coeff_t PolyEvalGrad(const Poly *p, unsigned n, const poly_coeff_t x[],
+                          poly_coeff_t grad[]) {
+    poly_coeff_t value;
+    PolyEvalGradBatch(p, n, 1, x, &value, grad);
+    return value;
+}
+
+void PolyEvalGradBatch(const Poly *p, unsigned n, unsigned count,
+                       const poly_coeff_t points[], poly_coeff_t values[],
+                       poly_coeff_t grads[]) {
+    unsigned levels = PolyDepth(p);
+    if (levels > n) {
+        levels = n;
+    }
+    size_t size = 0;
+    for (unsigned d = 0; d < levels; d++) {
+        size += (size_t) count * (n - d + 1);
+    }
+    poly_coeff_t *scratch = malloc(size * sizeof(poly_coeff_t));
+    EvalGradBatchRec(p, 0, n, count, points, values, grads, scratch);
+    free(scratch);
+}
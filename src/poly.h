@@ -10,6 +10,7 @@
 #ifndef __POLY_H__
 #define __POLY_H__
 
+#include <limits.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdio.h>
@@ -129,6 +130,14 @@ static inline Mono MonoClone(const Mono *m) {
     return (Mono) {.p = PolyClone(&m->p), .exp = m->exp, .next = m->next};
 }
 
+/**
+ * Tworzy kopię wielomianu pomnożoną przez stałą.
+ * @param[in] p : wielomian
+ * @param[in] c : stała
+ * @return `c * p`
+ */
+Poly PolyCloneTimesC(const Poly *p, poly_coeff_t c);
+
 /**
  * Dodaje dwa wielomiany.
  * @param[in] p : wielomian
@@ -227,4 +236,238 @@ void AppendPoly(Poly *p, Poly *q, poly_exp_t e);
  */
 void PolyMulByConstant(Poly *p, poly_coeff_t c);
 
+/**
+ * Zwraca x^exp
+ * @param[in] x : podstawa
+ * @param[in] exp : wykładnik
+ * @return x^exp
+ */
+poly_coeff_t ipow(poly_coeff_t x, poly_exp_t exp);
+
+/**
+ * Zwraca liczbę jednomianów wielomianu (bez jednomianów współczynników)
+ * @param[in] p : wskaźnik na wielomian
+ * @return liczba jednomianów
+ */
+int PolyLen(const Poly *p);
+
+/**
+ * Zwraca liczbę jednomianów wielomianu razem z jednomianami współczynników
+ * @param[in] p : wskaźnik na wielomian
+ * @return liczba jednomianów
+ */
+size_t PolyTermCount(const Poly *p);
+
+/**
+ * Zwraca listę jednomianów wielomianu, traktując niezerową stałą `c`
+ * jako jednomian `c * x^0`.
+ * @param[in] p : wskaźnik na wielomian
+ * @param[out] tmp : miejsce na jednomian reprezentujący stałą
+ * @return pierwszy jednomian (NULL dla wielomianu zerowego)
+ */
+const Mono *PolyTerms(const Poly *p, Mono *tmp);
+
+/**
+ * Struktura budująca wielomian w postaci normalnej z kolejnych jednomianów
+ * (bez osobnego przejścia PolyNormalize())
+ */
+typedef struct PolyBuilder {
+    Mono *head; ///< pierwszy jednomian (NULL jeżeli jeszcze nie ma jednomianów)
+    Mono *last; ///< ostatni jednomian
+} PolyBuilder;
+
+/**
+ * Zwraca pusty budowniczy wielomianu
+ * @return budowniczy wielomianu zerowego
+ */
+static inline PolyBuilder EmptyPolyBuilder() {
+    return (PolyBuilder) {.head = NULL, .last = NULL};
+}
+
+/**
+ * Dołącza jednomian `p * x^e` na koniec budowanego wielomianu.
+ * Przejmuje na własność wielomian @p p, który musi być w postaci normalnej.
+ * Wykładnik @p e musi być większy od wykładników dołączonych wcześniej.
+ * Zerowy współczynnik nie jest dołączany (i nie alokuje pamięci).
+ * @param[in] b : wskaźnik na budowniczego
+ * @param[in] p : wskaźnik na współczynnik
+ * @param[in] e : wykładnik
+ */
+void PolyBuilderAppend(PolyBuilder *b, Poly *p, poly_exp_t e);
+
+/**
+ * Dołącza zaalokowany jednomian na koniec budowanego wielomianu,
+ * przejmując go na własność (jednomian o zerowym współczynniku jest
+ * usuwany). Warunki jak w PolyBuilderAppend().
+ * @param[in] b : wskaźnik na budowniczego
+ * @param[in] m : wskaźnik na jednomian
+ */
+void PolyBuilderAppendMono(PolyBuilder *b, Mono *m);
+
+/**
+ * Kończy budowę wielomianu.
+ * Wielomian postaci `c * x^0` jest zamieniany na stałą `c`.
+ * @param[in] b : wskaźnik na budowniczego (po wywołaniu jest pusty)
+ * @return zbudowany wielomian w postaci normalnej
+ */
+Poly PolyBuilderFinish(PolyBuilder *b);
+
+/**
+ * Wartość oznaczająca brak ograniczenia stopnia
+ */
+#define POLY_EXP_UNBOUNDED INT_MAX
+
+/**
+ * Struktura opisująca ograniczenie stopnia wielomianu.
+ * Jednomian mieści się w ograniczeniu, jeżeli jego stopień całkowity nie
+ * przekracza @p total oraz jego stopień ze względu na zmienną o indeksie
+ * `i < var_count` nie przekracza `by_var[i]`.
+ */
+typedef struct PolyBound {
+    poly_exp_t total; ///< ograniczenie stopnia całkowitego
+    const poly_exp_t *by_var; ///< ograniczenia stopni kolejnych zmiennych (może być NULL)
+    unsigned var_count; ///< długość tablicy @p by_var
+} PolyBound;
+
+/**
+ * Tworzy ograniczenie stopnia całkowitego.
+ * @param[in] deg : maksymalny stopień całkowity
+ * @return ograniczenie
+ */
+static inline PolyBound PolyBoundTotal(poly_exp_t deg) {
+    return (PolyBound) {.total = deg, .by_var = NULL, .var_count = 0};
+}
+
+/**
+ * Tworzy ograniczenie stopni poszczególnych zmiennych.
+ * Zmienne o indeksach >= @p count nie są ograniczone.
+ * @param[in] count : liczba ograniczanych zmiennych
+ * @param[in] bounds : maksymalne stopnie kolejnych zmiennych
+ * @return ograniczenie
+ */
+static inline PolyBound PolyBoundByVar(unsigned count,
+                                       const poly_exp_t bounds[]) {
+    return (PolyBound) {
+            .total = POLY_EXP_UNBOUNDED, .by_var = bounds, .var_count = count
+    };
+}
+
+/**
+ * Obcina wielomian, usuwając jednomiany wykraczające poza ograniczenie.
+ * @param[in] p : wielomian
+ * @param[in] bound : ograniczenie stopnia
+ * @return @p p bez jednomianów spoza @p bound
+ */
+Poly PolyTrunc(const Poly *p, const PolyBound *bound);
+
+/**
+ * Dodaje dwa wielomiany, pomijając jednomiany spoza ograniczenia.
+ * @param[in] p : wielomian
+ * @param[in] q : wielomian
+ * @param[in] bound : ograniczenie stopnia
+ * @return `p + q` obcięte do @p bound
+ */
+Poly PolyAddTrunc(const Poly *p, const Poly *q, const PolyBound *bound);
+
+/**
+ * Mnoży dwa wielomiany, nie wyliczając jednomianów spoza ograniczenia.
+ * Iloczyny par jednomianów, których wykładniki przekraczają ograniczenie,
+ * nie są w ogóle tworzone (iloczyn krótki).
+ * @param[in] p : wielomian
+ * @param[in] q : wielomian
+ * @param[in] bound : ograniczenie stopnia
+ * @return `p * q` obcięte do @p bound
+ */
+Poly PolyMulTrunc(const Poly *p, const Poly *q, const PolyBound *bound);
+
+/**
+ * Podnosi wielomian do potęgi, obcinając wyniki pośrednie.
+ * @param[in] p : wielomian
+ * @param[in] n : nieujemny wykładnik
+ * @param[in] bound : ograniczenie stopnia
+ * @return `p^n` obcięte do @p bound
+ */
+Poly PolyPowTrunc(const Poly *p, poly_exp_t n, const PolyBound *bound);
+
+/**
+ * Podnosi wielomian do potęgi.
+ * @param[in] p : wielomian
+ * @param[in] n : nieujemny wykładnik
+ * @return `p^n`
+ */
+Poly PolyPow(const Poly *p, poly_exp_t n);
+
+/**
+ * Składa wielomian @p p z wielomianami @p q.
+ * Pod zmienną @f$x_i@f$ wstawia wielomian `q[i]` dla `i < k`
+ * oraz zero dla `i >= k`.
+ * Każda potrzebna potęga `q[i]` jest liczona tylko raz, a wynik jest
+ * wyliczany schematem Hornera względem kolejnych zmiennych.
+ * @param[in] p : wielomian
+ * @param[in] k : liczba podstawianych wielomianów
+ * @param[in] q : tablica podstawianych wielomianów
+ * @return @f$p(q_0, q_1, \ldots, q_{k-1}, 0, \ldots)@f$
+ */
+Poly PolyCompose(const Poly *p, unsigned k, const Poly q[]);
+
+/**
+ * Struktura opisująca wartość podstawianą pod zmienną
+ */
+typedef struct PolyVarValue {
+    unsigned var_idx; ///< indeks zmiennej
+    poly_coeff_t value; ///< podstawiana wartość
+} PolyVarValue;
+
+/**
+ * Wylicza wartość wielomianu po podstawieniu wartości pod wybrane zmienne.
+ * Podstawione zmienne znikają z wielomianu, a indeksy pozostałych zmiennych
+ * są zmniejszane o liczbę podstawionych zmiennych o mniejszych indeksach
+ * (tak jak w PolyAt()).
+ * Wynik jest wyliczany w jednym przejściu po wielomianie, potęgi każdej
+ * wartości są liczone raz, a poddrzewa niezawierające podstawianych
+ * zmiennych są kopiowane bez zmian.
+ * @param[in] p : wielomian
+ * @param[in] count : liczba podstawianych zmiennych
+ * @param[in] values : podstawienia (indeksy zmiennych są parami różne)
+ * @return wielomian po podstawieniu
+ */
+Poly PolyAtVars(const Poly *p, unsigned count, const PolyVarValue values[]);
+
+/**
+ * Wylicza pochodną cząstkową wielomianu względem zadanej zmiennej.
+ * @param[in] p : wielomian
+ * @param[in] var_idx : indeks zmiennej
+ * @return @f$\partial p / \partial x_{var\_idx}@f$
+ */
+Poly PolyDerive(const Poly *p, unsigned var_idx);
+
+/**
+ * Wylicza wartość i gradient wielomianu w punkcie w jednym przejściu
+ * po wielomianie (bez tworzenia wielomianów pochodnych).
+ * Pod zmienne o indeksach >= @p n podstawiane jest zero.
+ * @param[in] p : wielomian
+ * @param[in] n : wymiar punktu
+ * @param[in] x : współrzędne punktu
+ * @param[out] grad : tablica długości @p n na pochodne cząstkowe
+ * @return wartość wielomianu w punkcie @p x
+ */
+poly_coeff_t PolyEvalGrad(const Poly *p, unsigned n, const poly_coeff_t x[],
+                          poly_coeff_t grad[]);
+
+/**
+ * Wylicza wartości i gradienty wielomianu w wielu punktach.
+ * Wynik jest taki jak PolyEvalGrad() dla każdego punktu, ale wielomian
+ * jest przechodzony tylko raz: przy każdym jednomianie aktualizowane są
+ * wartości i gradienty wszystkich punktów.
+ * @param[in] p : wielomian
+ * @param[in] n : wymiar punktów
+ * @param[in] count : liczba punktów
+ * @param[in] points : współrzędne punktów (`count * n` liczb, wierszami)
+ * @param[out] values : tablica długości @p count na wartości
+ * @param[out] grads : tablica długości `count * n` na gradienty (wierszami)
+ */
+void PolyEvalGradBatch(const Poly *p, unsigned n, unsigned count,
+                       const poly_coeff_t points[], poly_coeff_t values[],
+                       poly_coeff_t grads[]);
+
 #endif /* __POLY_H__ */
\ No newline at end of file
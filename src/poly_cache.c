@@ -0,0 +1,309 @@
+/** @file
+   Implementacja pamięci podręcznej wyników operacji na wielomianach
+
+   @copyright Uniwersytet Warszawski
+   @date 2026-10-19
+*/
+
+#include <stdlib.h>
+#include "poly_cache.h"
+
+/**
+ * Początkowa liczba list wpisów
+ */
+#define INITIAL_BUCKET_COUNT 16
+
+/**
+ * Rodzaj zapamiętanej operacji
+ */
+typedef enum CacheOp {
+    CACHE_MUL, ///< PolyMul()
+    CACHE_AT, ///< PolyAt()
+    CACHE_POW ///< PolyPow()
+} CacheOp;
+
+/**
+ * Struktura wpisu pamięci podręcznej
+ */
+typedef struct PolyCacheEntry {
+    CacheOp op; ///< operacja
+    size_t hash; ///< skrót argumentów
+    Poly a; ///< pierwszy argument
+    Poly b; ///< drugi argument (dla @p CACHE_MUL)
+    poly_coeff_t arg; ///< argument liczbowy (dla @p CACHE_AT i @p CACHE_POW)
+    Poly result; ///< wynik
+    size_t bytes; ///< pamięć zajmowana przez wpis
+    struct PolyCacheEntry *chain; ///< następny wpis na liście o tym skrócie
+    struct PolyCacheEntry *newer; ///< wpis użyty później
+    struct PolyCacheEntry *older; ///< wpis użyty wcześniej
+} PolyCacheEntry;
+
+/**
+ * Dołącza wartość do skrótu
+ * @param h : skrót
+ * @param v : wartość
+ * @return nowy skrót
+ */
+static inline size_t HashMix(size_t h, size_t v) {
+    return (h ^ v) * 0x100000001b3u + (h >> 29);
+}
+
+/**
+ * Wylicza skrót wielomianu zależny tylko od jego struktury
+ * @param p : wielomian
+ * @return skrót
+ */
+static size_t PolyHash(const Poly *p) {
+    if (PolyIsCoeff(p)) {
+        return HashMix(0x9e3779b9u, (size_t) p->coeff);
+    }
+    size_t h = 0x7f4a7c15u;
+    for (Mono *m = p->head; m != NULL; m = m->next) {
+        h = HashMix(h, (size_t) m->exp);
+        h = HashMix(h, PolyHash(&m->p));
+    }
+    return h;
+}
+
+/**
+ * Zwraca listę, na której leżą wpisy o danym skrócie
+ * @param cache : wskaźnik na pamięć podręczną
+ * @param hash : skrót
+ * @return wskaźnik na początek listy
+ */
+static inline PolyCacheEntry **Bucket(PolyCache *cache, size_t hash) {
+    return &cache->buckets[hash & (cache->bucket_count - 1)];
+}
+
+/**
+ * Odłącza wpis od kolejki LRU
+ * @param cache : wskaźnik na pamięć podręczną
+ * @param e : wskaźnik na wpis
+ */
+static void LruUnlink(PolyCache *cache, PolyCacheEntry *e) {
+    if (e->newer != NULL) {
+        e->newer->older = e->older;
+    }
+    else {
+        cache->newest = e->older;
+    }
+    if (e->older != NULL) {
+        e->older->newer = e->newer;
+    }
+    else {
+        cache->oldest = e->newer;
+    }
+}
+
+/**
+ * Wstawia wpis na początek kolejki LRU
+ * @param cache : wskaźnik na pamięć podręczną
+ * @param e : wskaźnik na wpis
+ */
+static void LruPushNewest(PolyCache *cache, PolyCacheEntry *e) {
+    e->newer = NULL;
+    e->older = cache->newest;
+    if (cache->newest != NULL) {
+        cache->newest->newer = e;
+    }
+    else {
+        cache->oldest = e;
+    }
+    cache->newest = e;
+}
+
+/**
+ * Usuwa wpis z pamięci podręcznej i zwalnia go
+ * @param cache : wskaźnik na pamięć podręczną
+ * @param e : wskaźnik na wpis
+ */
+static void EntryRemove(PolyCache *cache, PolyCacheEntry *e) {
+    PolyCacheEntry **link = Bucket(cache, e->hash);
+    while (*link != e) {
+        link = &(*link)->chain;
+    }
+    *link = e->chain;
+    LruUnlink(cache, e);
+    cache->count--;
+    cache->bytes -= e->bytes;
+    PolyDestroy(&e->a);
+    PolyDestroy(&e->b);
+    PolyDestroy(&e->result);
+    free(e);
+}
+
+/**
+ * Sprawdza, czy pamięć podręczna mieści się w limitach
+ * @param cache : wskaźnik na pamięć podręczną
+ * @return czy limity są zachowane?
+ */
+static bool WithinLimits(const PolyCache *cache) {
+    return (cache->max_count == 0 || cache->count <= cache->max_count) &&
+           (cache->max_bytes == 0 || cache->bytes <= cache->max_bytes);
+}
+
+/**
+ * Podwaja liczbę list wpisów
+ * @param cache : wskaźnik na pamięć podręczną
+ */
+static void Rehash(PolyCache *cache) {
+    size_t old_count = cache->bucket_count;
+    PolyCacheEntry **old = cache->buckets;
+    cache->bucket_count = old_count == 0 ? INITIAL_BUCKET_COUNT
+                                         : 2 * old_count;
+    cache->buckets = calloc(cache->bucket_count, sizeof(PolyCacheEntry *));
+    for (size_t i = 0; i < old_count; i++) {
+        PolyCacheEntry *e = old[i];
+        while (e != NULL) {
+            PolyCacheEntry *next = e->chain;
+            PolyCacheEntry **bucket = Bucket(cache, e->hash);
+            e->chain = *bucket;
+            *bucket = e;
+            e = next;
+        }
+    }
+    free(old);
+}
+
+/**
+ * Wyszukuje wpis
+ * @param cache : wskaźnik na pamięć podręczną
+ * @param op : operacja
+ * @param hash : skrót argumentów
+ * @param a : pierwszy argument
+ * @param b : drugi argument (dla @p CACHE_MUL)
+ * @param arg : argument liczbowy
+ * @return wskaźnik na wpis lub NULL, jeżeli go nie ma
+ */
+static PolyCacheEntry *Lookup(PolyCache *cache, CacheOp op, size_t hash,
+                              const Poly *a, const Poly *b,
+                              poly_coeff_t arg) {
+    if (cache->bucket_count == 0) {
+        return NULL;
+    }
+    for (PolyCacheEntry *e = *Bucket(cache, hash); e != NULL; e = e->chain) {
+        if (e->hash == hash && e->op == op && e->arg == arg &&
+            PolyIsEq(&e->a, a) && (op != CACHE_MUL || PolyIsEq(&e->b, b))) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Zwraca zapamiętany wynik operacji, a jeżeli go nie ma, wylicza go
+ * i zapamiętuje
+ * @param cache : wskaźnik na pamięć podręczną
+ * @param op : operacja
+ * @param hash : skrót argumentów
+ * @param a : pierwszy argument
+ * @param b : drugi argument (dla @p CACHE_MUL)
+ * @param arg : argument liczbowy
+ * @return wynik operacji
+ */
+static Poly CacheGet(PolyCache *cache, CacheOp op, size_t hash,
+                     const Poly *a, const Poly *b, poly_coeff_t arg) {
+    PolyCacheEntry *e = Lookup(cache, op, hash, a, b, arg);
+    if (e != NULL) {
+        cache->stats.hits++;
+        LruUnlink(cache, e);
+        LruPushNewest(cache, e);
+        return PolyClone(&e->result);
+    }
+
+    cache->stats.misses++;
+    Poly result;
+    switch (op) {
+        case CACHE_MUL:
+            result = PolyMul(a, b);
+            break;
+        case CACHE_AT:
+            result = PolyAt(a, arg);
+            break;
+        default:
+            result = PolyPow(a, (poly_exp_t) arg);
+            break;
+    }
+
+    size_t monos = PolyTermCount(a) + PolyTermCount(&result);
+    if (op == CACHE_MUL) {
+        monos += PolyTermCount(b);
+    }
+    size_t bytes = sizeof(PolyCacheEntry) + monos * sizeof(Mono);
+    if (cache->max_bytes != 0 && bytes > cache->max_bytes) {
+        return result;
+    }
+
+    e = malloc(sizeof(PolyCacheEntry));
+    e->op = op;
+    e->hash = hash;
+    e->a = PolyClone(a);
+    e->b = op == CACHE_MUL ? PolyClone(b) : PolyZero();
+    e->arg = arg;
+    e->result = PolyClone(&result);
+    e->bytes = bytes;
+    if (cache->count >= cache->bucket_count) {
+        Rehash(cache);
+    }
+    PolyCacheEntry **bucket = Bucket(cache, hash);
+    e->chain = *bucket;
+    *bucket = e;
+    LruPushNewest(cache, e);
+    cache->count++;
+    cache->bytes += bytes;
+
+    while (!WithinLimits(cache)) {
+        EntryRemove(cache, cache->oldest);
+        cache->stats.evictions++;
+    }
+    return result;
+}
+
+void PolyCacheClear(PolyCache *cache) {
+    while (cache->oldest != NULL) {
+        EntryRemove(cache, cache->oldest);
+    }
+}
+
+void PolyCacheDestroy(PolyCache *cache) {
+    PolyCacheClear(cache);
+    free(cache->buckets);
+    cache->buckets = NULL;
+    cache->bucket_count = 0;
+}
+
+void PolyCacheInvalidate(PolyCache *cache, const Poly *p) {
+    PolyCacheEntry *e = cache->oldest;
+    while (e != NULL) {
+        PolyCacheEntry *next = e->newer;
+        if (PolyIsEq(&e->a, p) || (e->op == CACHE_MUL && PolyIsEq(&e->b, p))) {
+            EntryRemove(cache, e);
+        }
+        e = next;
+    }
+}
+
+Poly PolyCacheMul(PolyCache *cache, const Poly *p, const Poly *q) {
+    size_t hp = PolyHash(p);
+    size_t hq = PolyHash(q);
+    if (hp > hq) {
+        const Poly *tmp = p;
+        p = q;
+        q = tmp;
+        size_t htmp = hp;
+        hp = hq;
+        hq = htmp;
+    }
+    size_t hash = HashMix(HashMix(CACHE_MUL, hp), hq);
+    return CacheGet(cache, CACHE_MUL, hash, p, q, 0);
+}
+
+Poly PolyCacheAt(PolyCache *cache, const Poly *p, poly_coeff_t x) {
+    size_t hash = HashMix(HashMix(CACHE_AT, PolyHash(p)), (size_t) x);
+    return CacheGet(cache, CACHE_AT, hash, p, NULL, x);
+}
+
+Poly PolyCachePow(PolyCache *cache, const Poly *p, poly_exp_t n) {
+    size_t hash = HashMix(HashMix(CACHE_POW, PolyHash(p)), (size_t) n);
+    return CacheGet(cache, CACHE_POW, hash, p, NULL, n);
+}
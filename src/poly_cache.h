@@ -0,0 +1,102 @@
+/** @file
+   Interfejs pamięci podręcznej wyników operacji na wielomianach
+
+   @copyright Uniwersytet Warszawski
+   @date 2026-10-19
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include "poly.h"
+
+/**
+ * Struktura statystyk pamięci podręcznej
+ */
+typedef struct PolyCacheStats {
+    size_t hits; ///< liczba wyników odczytanych z pamięci podręcznej
+    size_t misses; ///< liczba wyników wyliczonych od nowa
+    size_t evictions; ///< liczba wpisów usuniętych z powodu limitów
+} PolyCacheStats;
+
+/**
+ * Struktura pamięci podręcznej wyników PolyMul(), PolyAt() i PolyPow().
+ * Wpisy są wyszukiwane po skrócie wyliczonym ze struktury argumentów,
+ * a argumenty są porównywane przez PolyIsEq(), więc wynik jest zwracany
+ * dla dowolnego wielomianu równego zapamiętanemu argumentowi. Gdy
+ * przekroczony zostanie limit liczby wpisów lub zajmowanej pamięci,
+ * usuwane są najdawniej używane wpisy.
+ */
+typedef struct PolyCache {
+    struct PolyCacheEntry **buckets; ///< listy wpisów o tym samym skrócie
+    size_t bucket_count; ///< liczba list (potęga dwójki)
+    struct PolyCacheEntry *newest; ///< ostatnio używany wpis
+    struct PolyCacheEntry *oldest; ///< najdawniej używany wpis
+    size_t count; ///< liczba wpisów
+    size_t bytes; ///< pamięć zajmowana przez wpisy
+    size_t max_count; ///< maksymalna liczba wpisów (0 - bez limitu)
+    size_t max_bytes; ///< maksymalna zajmowana pamięć (0 - bez limitu)
+    PolyCacheStats stats; ///< statystyki
+} PolyCache;
+
+/**
+ * Tworzy pustą pamięć podręczną
+ * @param[in] max_count : maksymalna liczba wpisów (0 - bez limitu)
+ * @param[in] max_bytes : maksymalna zajmowana pamięć w bajtach
+ *                        (0 - bez limitu)
+ * @return pusta pamięć podręczna
+ */
+static inline PolyCache EmptyPolyCache(size_t max_count, size_t max_bytes) {
+    return (PolyCache) {
+            .buckets = NULL, .bucket_count = 0, .newest = NULL,
+            .oldest = NULL, .count = 0, .bytes = 0, .max_count = max_count,
+            .max_bytes = max_bytes, .stats = {0, 0, 0}
+    };
+}
+
+/**
+ * Usuwa pamięć podręczną wraz ze wszystkimi wpisami
+ * @param[in] cache : wskaźnik na pamięć podręczną
+ */
+void PolyCacheDestroy(PolyCache *cache);
+
+/**
+ * Usuwa wszystkie wpisy (statystyki są zachowywane)
+ * @param[in] cache : wskaźnik na pamięć podręczną
+ */
+void PolyCacheClear(PolyCache *cache);
+
+/**
+ * Usuwa wpisy, których argumentem jest wielomian równy @p p
+ * @param[in] cache : wskaźnik na pamięć podręczną
+ * @param[in] p : wielomian
+ */
+void PolyCacheInvalidate(PolyCache *cache, const Poly *p);
+
+/**
+ * Mnoży dwa wielomiany, korzystając z pamięci podręcznej
+ * @param[in] cache : wskaźnik na pamięć podręczną
+ * @param[in] p : wielomian @f$p@f$
+ * @param[in] q : wielomian @f$q@f$
+ * @return @f$p * q@f$
+ */
+Poly PolyCacheMul(PolyCache *cache, const Poly *p, const Poly *q);
+
+/**
+ * Wylicza wartość wielomianu w punkcie @p x, korzystając z pamięci
+ * podręcznej
+ * @param[in] cache : wskaźnik na pamięć podręczną
+ * @param[in] p : wielomian @f$p@f$
+ * @param[in] x : wartość argumentu @f$x@f$
+ * @return @f$p(x, x_0, x_1, \ldots)@f$
+ */
+Poly PolyCacheAt(PolyCache *cache, const Poly *p, poly_coeff_t x);
+
+/**
+ * Podnosi wielomian do potęgi, korzystając z pamięci podręcznej
+ * @param[in] cache : wskaźnik na pamięć podręczną
+ * @param[in] p : wielomian @f$p@f$
+ * @param[in] n : wykładnik @f$n \geq 0@f$
+ * @return @f$p^n@f$
+ */
+Poly PolyCachePow(PolyCache *cache, const Poly *p, poly_exp_t n);
@@ -0,0 +1,251 @@
+/** @file
+   Implementacja puli wątków wyliczających wartości wielomianów
+
+   @copyright Uniwersytet Warszawski
+   @date 2026-10-19
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "poly_eval_pool.h"
+
+/**
+ * Rozmiar linii pamięci podręcznej
+ */
+#define CACHE_LINE_SIZE 64
+
+/**
+ * Maksymalna liczba zadań przetwarzanych w jednej turze
+ */
+#define MAX_ROUND_JOBS UINT32_MAX
+
+/**
+ * Struktura wątku puli.
+ * Zakres zadań wątku `[begin, end)` jest zapisany w jednej liczbie
+ * 64-bitowej, dzięki czemu właściciel (pobierający zadania z początku)
+ * i inne wątki (przejmujące koniec zakresu) synchronizują się jedną
+ * operacją compare-and-swap.
+ */
+typedef struct PoolWorker {
+    _Alignas(CACHE_LINE_SIZE) _Atomic uint64_t range; ///< `begin << 32 | end`
+    pthread_t thread; ///< wątek (nieużywany dla wątku wywołującego)
+    struct PolyEvalPool *pool; ///< pula
+    unsigned id; ///< numer wątku
+} PoolWorker;
+
+/**
+ * Struktura puli wątków
+ */
+struct PolyEvalPool {
+    PoolWorker *workers; ///< wątki; wątek 0 to wątek wywołujący
+    unsigned count; ///< liczba wątków
+    const PolyEvalJob *jobs; ///< zadania bieżącej tury
+    poly_coeff_t *results; ///< wyniki bieżącej tury
+    pthread_mutex_t lock; ///< blokada chroniąca pola poniżej
+    pthread_cond_t start; ///< sygnał rozpoczęcia tury
+    pthread_cond_t done; ///< sygnał zakończenia pracy ostatniego wątku
+    unsigned long round; ///< numer tury
+    unsigned active; ///< liczba wątków pracujących w bieżącej turze
+    bool stop; ///< czy wątki mają się zakończyć?
+};
+
+/**
+ * Tworzy zakres zadań
+ * @param begin : początek zakresu
+ * @param end : koniec zakresu
+ * @return zakres
+ */
+static inline uint64_t MakeRange(uint32_t begin, uint32_t end) {
+    return (uint64_t) begin << 32 | end;
+}
+
+/**
+ * Pobiera zadanie z początku własnego zakresu
+ * @param w : wskaźnik na wątek
+ * @param job : miejsce na indeks zadania
+ * @return czy udało się pobrać zadanie?
+ */
+static bool TakeOwn(PoolWorker *w, uint32_t *job) {
+    uint64_t range = atomic_load_explicit(&w->range, memory_order_acquire);
+    for (;;) {
+        uint32_t begin = (uint32_t) (range >> 32);
+        uint32_t end = (uint32_t) range;
+        if (begin >= end) {
+            return false;
+        }
+        if (atomic_compare_exchange_weak_explicit(
+                &w->range, &range, MakeRange(begin + 1, end),
+                memory_order_acq_rel, memory_order_acquire)) {
+            *job = begin;
+            return true;
+        }
+    }
+}
+
+/**
+ * Przejmuje połowę pozostałych zadań innego wątku
+ * @param pool : wskaźnik na pulę
+ * @param w : wskaźnik na wątek przejmujący (z pustym zakresem)
+ * @return czy udało się przejąć zadania? (false, jeżeli wszystkie
+ * zakresy są puste)
+ */
+static bool Steal(PolyEvalPool *pool, PoolWorker *w) {
+    for (unsigned k = 1; k < pool->count; k++) {
+        PoolWorker *victim = &pool->workers[(w->id + k) % pool->count];
+        uint64_t range = atomic_load_explicit(&victim->range,
+                                              memory_order_acquire);
+        for (;;) {
+            uint32_t begin = (uint32_t) (range >> 32);
+            uint32_t end = (uint32_t) range;
+            if (begin >= end) {
+                break;
+            }
+            uint32_t mid = begin + (end - begin) / 2;
+            if (atomic_compare_exchange_weak_explicit(
+                    &victim->range, &range, MakeRange(begin, mid),
+                    memory_order_acq_rel, memory_order_acquire)) {
+                atomic_store_explicit(&w->range, MakeRange(mid, end),
+                                      memory_order_release);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Wylicza zadania bieżącej tury, dopóki jakieś zostały
+ * @param pool : wskaźnik na pulę
+ * @param w : wskaźnik na wątek
+ */
+static void WorkerRun(PolyEvalPool *pool, PoolWorker *w) {
+    const PolyEvalJob *jobs = pool->jobs;
+    poly_coeff_t *results = pool->results;
+    for (;;) {
+        uint32_t i;
+        if (TakeOwn(w, &i)) {
+            results[i] = PolyPackedAt(jobs[i].poly, jobs[i].n, jobs[i].point);
+        }
+        else if (!Steal(pool, w)) {
+            break;
+        }
+    }
+}
+
+/**
+ * Funkcja wątku puli: czeka na kolejne tury i je wylicza
+ * @param arg : wskaźnik na wątek
+ * @return NULL
+ */
+static void *WorkerMain(void *arg) {
+    PoolWorker *w = arg;
+    PolyEvalPool *pool = w->pool;
+    unsigned long seen = 0;
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while (pool->round == seen && !pool->stop) {
+            pthread_cond_wait(&pool->start, &pool->lock);
+        }
+        if (pool->stop) {
+            pthread_mutex_unlock(&pool->lock);
+            return NULL;
+        }
+        seen = pool->round;
+        pthread_mutex_unlock(&pool->lock);
+
+        WorkerRun(pool, w);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->active == 0) {
+            pthread_cond_signal(&pool->done);
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+PolyEvalPool *PolyEvalPoolCreate(unsigned threads) {
+    if (threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (unsigned) cpus : 1;
+    }
+    PolyEvalPool *pool = malloc(sizeof(PolyEvalPool));
+    pool->count = threads;
+    pool->workers = aligned_alloc(CACHE_LINE_SIZE,
+                                  threads * sizeof(PoolWorker));
+    pool->jobs = NULL;
+    pool->results = NULL;
+    pool->round = 0;
+    pool->active = 0;
+    pool->stop = false;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    for (unsigned i = 0; i < threads; i++) {
+        PoolWorker *w = &pool->workers[i];
+        atomic_init(&w->range, 0);
+        w->pool = pool;
+        w->id = i;
+        if (i > 0 && pthread_create(&w->thread, NULL, WorkerMain, w) != 0) {
+            // pracujemy na wątkach, które udało się utworzyć
+            pool->count = i;
+            break;
+        }
+    }
+    return pool;
+}
+
+void PolyEvalPoolDestroy(PolyEvalPool *pool) {
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+    for (unsigned i = 1; i < pool->count; i++) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->start);
+    pthread_cond_destroy(&pool->done);
+    free(pool->workers);
+    free(pool);
+}
+
+void PolyEvalPoolRun(PolyEvalPool *pool, size_t count,
+                     const PolyEvalJob jobs[], poly_coeff_t results[]) {
+    while (count > 0) {
+        uint32_t round_count = count < MAX_ROUND_JOBS ? (uint32_t) count
+                                                      : MAX_ROUND_JOBS;
+        pool->jobs = jobs;
+        pool->results = results;
+        for (unsigned i = 0; i < pool->count; i++) {
+            uint32_t begin = (uint32_t) ((uint64_t) round_count * i /
+                                         pool->count);
+            uint32_t end = (uint32_t) ((uint64_t) round_count * (i + 1) /
+                                       pool->count);
+            atomic_store_explicit(&pool->workers[i].range,
+                                  MakeRange(begin, end), memory_order_relaxed);
+        }
+
+        pthread_mutex_lock(&pool->lock);
+        pool->active = pool->count - 1;
+        pool->round++;
+        pthread_cond_broadcast(&pool->start);
+        pthread_mutex_unlock(&pool->lock);
+
+        WorkerRun(pool, &pool->workers[0]);
+
+        pthread_mutex_lock(&pool->lock);
+        while (pool->active > 0) {
+            pthread_cond_wait(&pool->done, &pool->lock);
+        }
+        pthread_mutex_unlock(&pool->lock);
+
+        jobs += round_count;
+        results += round_count;
+        count -= round_count;
+    }
+}
@@ -0,0 +1,57 @@
+/** @file
+   Interfejs puli wątków wyliczających wartości wielomianów
+
+   @copyright Uniwersytet Warszawski
+   @date 2026-10-19
+*/
+
+#pragma once
+
+#include "poly_packed.h"
+
+/**
+ * Struktura zadania: wyliczenie wartości wielomianu w punkcie.
+ * Wielomian w zwartej postaci jest tylko odczytywany, więc jeden
+ * wielomian może być współdzielony przez dowolnie wiele zadań i wątków.
+ */
+typedef struct PolyEvalJob {
+    const PolyPacked *poly; ///< wielomian (utworzony przez PolyPack())
+    const poly_coeff_t *point; ///< współrzędne punktu
+    unsigned n; ///< wymiar punktu
+} PolyEvalJob;
+
+/**
+ * typedef struktury puli wątków
+ */
+typedef struct PolyEvalPool PolyEvalPool;
+
+/**
+ * Tworzy pulę wątków.
+ * @param[in] threads : liczba wątków (0 oznacza liczbę dostępnych
+ *                      procesorów); wątek wywołujący PolyEvalPoolRun()
+ *                      jest jednym z nich
+ * @return wskaźnik na pulę. Jeżeli nie uda się utworzyć któregoś wątku,
+ * pula korzysta z wątków utworzonych wcześniej (w skrajnym przypadku
+ * tylko z wątku wywołującego PolyEvalPoolRun()).
+ */
+PolyEvalPool *PolyEvalPoolCreate(unsigned threads);
+
+/**
+ * Kończy wątki puli i usuwa ją z pamięci
+ * @param[in] pool : wskaźnik na pulę
+ */
+void PolyEvalPoolDestroy(PolyEvalPool *pool);
+
+/**
+ * Wylicza wyniki zadań, rozdzielając je między wątki puli.
+ * Każdy wątek zaczyna od równego fragmentu zadań, a po jego wyczerpaniu
+ * przejmuje połowę pozostałych zadań innego wątku. Pobieranie zadań nie
+ * wymaga blokad. Funkcja wraca po wyliczeniu wszystkich wyników.
+ * Pula może być używana jednocześnie tylko przez jeden wątek.
+ * @param[in] pool : wskaźnik na pulę
+ * @param[in] count : liczba zadań
+ * @param[in] jobs : zadania
+ * @param[out] results : tablica długości @p count na wyniki
+ */
+void PolyEvalPoolRun(PolyEvalPool *pool, size_t count,
+                     const PolyEvalJob jobs[], poly_coeff_t results[]);
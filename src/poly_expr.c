@@ -0,0 +1,509 @@
+/** @file
+   Implementacja leniwych wyrażeń na wielomianach
+
+   @copyright Uniwersytet Warszawski
+   @date 2026-10-19
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "poly_expr.h"
+
+/**
+ * Początkowy rozmiar tablic grafu
+ */
+#define INITIAL_GRAPH_SIZE 16
+
+/**
+ * Struktura składnika kombinacji liniowej węzłów
+ */
+typedef struct ExprTerm {
+    PolyExpr node; ///< węzeł
+    poly_coeff_t coeff; ///< współczynnik, przez który mnożony jest węzeł
+} ExprTerm;
+
+/**
+ * Struktura kombinacji liniowej węzłów
+ */
+typedef struct ExprTerms {
+    ExprTerm *terms; ///< składniki
+    unsigned int count; ///< liczba składników
+    unsigned int size; ///< rozmiar tablicy @p terms
+    poly_coeff_t constant; ///< wyraz wolny
+} ExprTerms;
+
+/**
+ * Wylicza skrót węzła
+ * @param n : wskaźnik na węzeł
+ * @return skrót
+ */
+static size_t NodeHash(const PolyExprNode *n) {
+    size_t h = n->kind;
+    h = h * 1000003u ^ n->a;
+    h = h * 1000003u ^ n->b;
+    h = h * 1000003u ^ (size_t) n->c;
+    h = h * 1000003u ^ (size_t) (uintptr_t) n->leaf;
+    return h;
+}
+
+/**
+ * Sprawdza, czy dwa węzły opisują to samo wyrażenie
+ * @param n : wskaźnik na pierwszy węzeł
+ * @param m : wskaźnik na drugi węzeł
+ * @return czy węzły są identyczne?
+ */
+static bool NodeIsEq(const PolyExprNode *n, const PolyExprNode *m) {
+    return n->kind == m->kind && n->a == m->a && n->b == m->b &&
+           n->c == m->c && n->leaf == m->leaf;
+}
+
+/**
+ * Wstawia indeks węzła do tablicy haszującej (zakłada, że jest miejsce)
+ * @param g : wskaźnik na graf
+ * @param e : indeks węzła
+ */
+static void TableInsert(PolyExprGraph *g, PolyExpr e) {
+    size_t i = NodeHash(&g->nodes[e]) & (g->table_size - 1);
+    while (g->table[i] != 0) {
+        i = (i + 1) & (g->table_size - 1);
+    }
+    g->table[i] = e + 1;
+}
+
+/**
+ * Zwraca węzeł identyczny z zadanym, dodając go do grafu, jeżeli
+ * jeszcze go tam nie ma
+ * @param g : wskaźnik na graf
+ * @param node : węzeł
+ * @return indeks węzła w grafie
+ */
+static PolyExpr NodeIntern(PolyExprGraph *g, PolyExprNode node) {
+    if (g->table_size != 0) {
+        size_t i = NodeHash(&node) & (g->table_size - 1);
+        while (g->table[i] != 0) {
+            if (NodeIsEq(&g->nodes[g->table[i] - 1], &node)) {
+                return g->table[i] - 1;
+            }
+            i = (i + 1) & (g->table_size - 1);
+        }
+    }
+    if (g->count == g->size) {
+        g->size = g->size == 0 ? INITIAL_GRAPH_SIZE : 2 * g->size;
+        g->nodes = realloc(g->nodes, g->size * sizeof(PolyExprNode));
+    }
+    PolyExpr e = g->count++;
+    g->nodes[e] = node;
+    if (node.kind == POLY_EXPR_ADD || node.kind == POLY_EXPR_MUL) {
+        g->nodes[node.a].uses++;
+        g->nodes[node.b].uses++;
+    }
+    else if (node.kind == POLY_EXPR_SCALE) {
+        g->nodes[node.a].uses++;
+    }
+    if (2 * g->count > g->table_size) {
+        free(g->table);
+        g->table_size = g->table_size == 0 ? 2 * INITIAL_GRAPH_SIZE
+                                           : 2 * g->table_size;
+        g->table = calloc(g->table_size, sizeof(unsigned int));
+        for (PolyExpr i = 0; i < g->count; i++) {
+            TableInsert(g, i);
+        }
+    }
+    else {
+        TableInsert(g, e);
+    }
+    return e;
+}
+
+/**
+ * Tworzy węzeł o zadanym rodzaju i argumentach
+ * @param kind : rodzaj węzła
+ * @param a : pierwszy argument
+ * @param b : drugi argument
+ * @param c : stała
+ * @param leaf : wskaźnik na wielomian
+ * @return węzeł
+ */
+static inline PolyExprNode NewNode(PolyExprKind kind, PolyExpr a, PolyExpr b,
+                                   poly_coeff_t c, const Poly *leaf) {
+    return (PolyExprNode) {
+            .kind = kind, .a = a, .b = b, .c = c, .leaf = leaf, .uses = 0,
+            .ready = false, .value = PolyZero()
+    };
+}
+
+void PolyExprGraphDestroy(PolyExprGraph *g) {
+    for (unsigned int i = 0; i < g->count; i++) {
+        if (g->nodes[i].ready) {
+            PolyDestroy(&g->nodes[i].value);
+        }
+    }
+    free(g->nodes);
+    free(g->table);
+    *g = EmptyExprGraph();
+}
+
+PolyExpr PolyExprLeaf(PolyExprGraph *g, const Poly *p) {
+    return NodeIntern(g, NewNode(POLY_EXPR_LEAF, 0, 0, 0, p));
+}
+
+PolyExpr PolyExprConst(PolyExprGraph *g, poly_coeff_t c) {
+    return NodeIntern(g, NewNode(POLY_EXPR_CONST, 0, 0, c, NULL));
+}
+
+PolyExpr PolyExprAdd(PolyExprGraph *g, PolyExpr a, PolyExpr b) {
+    if (a > b) {
+        PolyExpr temp = a;
+        a = b;
+        b = temp;
+    }
+    return NodeIntern(g, NewNode(POLY_EXPR_ADD, a, b, 0, NULL));
+}
+
+PolyExpr PolyExprSub(PolyExprGraph *g, PolyExpr a, PolyExpr b) {
+    return PolyExprAdd(g, a, PolyExprNeg(g, b));
+}
+
+PolyExpr PolyExprMul(PolyExprGraph *g, PolyExpr a, PolyExpr b) {
+    if (a > b) {
+        PolyExpr temp = a;
+        a = b;
+        b = temp;
+    }
+    return NodeIntern(g, NewNode(POLY_EXPR_MUL, a, b, 0, NULL));
+}
+
+PolyExpr PolyExprNeg(PolyExprGraph *g, PolyExpr a) {
+    return PolyExprScale(g, a, -1);
+}
+
+PolyExpr PolyExprScale(PolyExprGraph *g, PolyExpr a, poly_coeff_t c) {
+    if (c == 1) {
+        return a;
+    }
+    if (c == 0) {
+        return PolyExprConst(g, 0);
+    }
+    if (g->nodes[a].kind == POLY_EXPR_CONST) {
+        return PolyExprConst(g, g->nodes[a].c * c);
+    }
+    if (g->nodes[a].kind == POLY_EXPR_SCALE) {
+        return PolyExprScale(g, g->nodes[a].a, g->nodes[a].c * c);
+    }
+    return NodeIntern(g, NewNode(POLY_EXPR_SCALE, a, 0, c, NULL));
+}
+
+/**
+ * Sprawdza, czy węzeł może zostać wyliczony razem z węzłem,
+ * który z niego korzysta
+ * @param g : wskaźnik na graf
+ * @param e : węzeł
+ * @param root : wyliczany węzeł
+ * @return czy węzeł nie musi być wyliczany osobno?
+ */
+static bool NodeIsFusible(const PolyExprGraph *g, PolyExpr e, PolyExpr root) {
+    return e == root || (g->nodes[e].uses <= 1 && !g->nodes[e].ready);
+}
+
+/**
+ * Dodaje składnik do kombinacji liniowej
+ * @param t : wskaźnik na kombinację liniową
+ * @param e : węzeł
+ * @param coeff : współczynnik
+ */
+static void TermsAdd(ExprTerms *t, PolyExpr e, poly_coeff_t coeff) {
+    if (t->count == t->size) {
+        t->size = t->size == 0 ? INITIAL_GRAPH_SIZE : 2 * t->size;
+        t->terms = realloc(t->terms, t->size * sizeof(ExprTerm));
+    }
+    t->terms[t->count++] = (ExprTerm) {.node = e, .coeff = coeff};
+}
+
+/**
+ * Rozwija drzewo sum i iloczynów przez stałą w kombinację liniową
+ * węzłów, które trzeba wyliczyć osobno
+ * @param g : wskaźnik na graf
+ * @param e : węzeł
+ * @param root : wyliczany węzeł
+ * @param coeff : współczynnik, przez który mnożony jest węzeł
+ * @param t : wskaźnik na kombinację liniową
+ */
+static void Flatten(const PolyExprGraph *g, PolyExpr e, PolyExpr root,
+                    poly_coeff_t coeff, ExprTerms *t) {
+    const PolyExprNode *n = &g->nodes[e];
+    if (n->kind == POLY_EXPR_CONST) {
+        t->constant += coeff * n->c;
+    }
+    else if (n->kind == POLY_EXPR_ADD && NodeIsFusible(g, e, root)) {
+        Flatten(g, n->a, root, coeff, t);
+        Flatten(g, n->b, root, coeff, t);
+    }
+    else if (n->kind == POLY_EXPR_SCALE && NodeIsFusible(g, e, root)) {
+        Flatten(g, n->a, root, coeff * n->c, t);
+    }
+    else {
+        TermsAdd(t, e, coeff);
+    }
+}
+
+/**
+ * Funkcja porównująca dwa składniki według węzłów
+ * @param t1 : wskaźnik na pierwszy składnik
+ * @param t2 : wskaźnik na drugi składnik
+ * @return -1, 0 lub 1 zależnie od wyniku porównania
+ */
+static int TermCmp(const void *t1, const void *t2) {
+    PolyExpr a = ((const ExprTerm *) t1)->node;
+    PolyExpr b = ((const ExprTerm *) t2)->node;
+    return a < b ? -1 : a > b;
+}
+
+/**
+ * Struktura składnika sumowanej kombinacji liniowej wielomianów
+ */
+typedef struct LinTerm {
+    const Poly *p; ///< wielomian
+    Poly *owned; ///< ten sam wielomian, jeżeli jest przejmowany na własność
+    poly_coeff_t c; ///< współczynnik, przez który mnożony jest wielomian
+} LinTerm;
+
+/**
+ * Struktura pozycji w liście jednomianów składnika kombinacji
+ */
+typedef struct LinCursor {
+    const Mono *m; ///< bieżący jednomian
+    Mono tmp; ///< jednomian reprezentujący stałą
+    Mono *taken; ///< jednomian zdjęty ze składnika przejmowanego
+} LinCursor;
+
+/**
+ * Liczba składników, dla których Combine() nie alokuje pamięci
+ * na tablice pomocnicze
+ */
+#define COMBINE_INLINE_TERMS 4
+
+static Poly Combine(unsigned int k, LinTerm terms[]);
+
+/**
+ * Scala listy jednomianów składników kombinacji (przynajmniej jeden
+ * z nich jest niestały). Współczynniki jednomianów o tym samym
+ * wykładniku są sumowane rekurencyjnie przez Combine().
+ * @param k : liczba składników
+ * @param terms : składniki
+ * @param cur : tablica pozycji długości @p k
+ * @param sub : tablica długości @p k na składniki sumy współczynników
+ * @return suma składników
+ */
+static Poly CombineMerge(unsigned int k, LinTerm terms[], LinCursor cur[],
+                         LinTerm sub[]) {
+    for (unsigned int i = 0; i < k; i++) {
+        cur[i].taken = NULL;
+        cur[i].m = PolyTerms(terms[i].p, &cur[i].tmp);
+    }
+
+    PolyBuilder builder = EmptyPolyBuilder();
+    for (;;) {
+        bool any = false;
+        poly_exp_t e = 0;
+        for (unsigned int i = 0; i < k; i++) {
+            if (cur[i].m != NULL && (!any || cur[i].m->exp < e)) {
+                e = cur[i].m->exp;
+                any = true;
+            }
+        }
+        if (!any) {
+            break;
+        }
+
+        unsigned int n = 0;
+        for (unsigned int i = 0; i < k; i++) {
+            if (cur[i].m == NULL || cur[i].m->exp != e) {
+                continue;
+            }
+            if (terms[i].owned != NULL && !PolyIsCoeff(terms[i].owned)) {
+                // jednomian składnika przejmowanego zdejmujemy z jego listy
+                Mono *m = terms[i].owned->head;
+                terms[i].owned->head = m->next;
+                cur[i].m = m->next;
+                cur[i].taken = m;
+                sub[n++] = (LinTerm) {.p = &m->p, .owned = &m->p,
+                                      .c = terms[i].c};
+            }
+            else {
+                sub[n++] = (LinTerm) {.p = &cur[i].m->p, .owned = NULL,
+                                      .c = terms[i].c};
+                cur[i].m = cur[i].m->next;
+            }
+        }
+        Poly t = Combine(n, sub);
+        // wynik zapisujemy w jednym ze zdjętych jednomianów
+        Mono *reuse = NULL;
+        for (unsigned int i = 0; i < k; i++) {
+            if (reuse == NULL) {
+                reuse = cur[i].taken;
+            }
+            else {
+                free(cur[i].taken);
+            }
+            cur[i].taken = NULL;
+        }
+        if (reuse != NULL) {
+            reuse->p = t;
+            reuse->exp = e;
+            PolyBuilderAppendMono(&builder, reuse);
+        }
+        else {
+            PolyBuilderAppend(&builder, &t, e);
+        }
+    }
+
+    for (unsigned int i = 0; i < k; i++) {
+        if (terms[i].owned != NULL) {
+            *terms[i].owned = PolyZero();
+        }
+    }
+    return PolyBuilderFinish(&builder);
+}
+
+/**
+ * Sumuje kombinację liniową wielomianów, scalając ich posortowane listy
+ * jednomianów. Wielomiany przejmowane na własność są po wywołaniu zerowe,
+ * a ich współczynniki, których nie trzeba z niczym sumować, są
+ * przenoszone do wyniku bez kopiowania.
+ * @param k : liczba składników (> 0)
+ * @param terms : składniki
+ * @return suma składników
+ */
+static Poly Combine(unsigned int k, LinTerm terms[]) {
+    bool all_coeff = true;
+    poly_coeff_t sum = 0;
+    for (unsigned int i = 0; i < k; i++) {
+        if (PolyIsCoeff(terms[i].p)) {
+            sum += terms[i].c * terms[i].p->coeff;
+        }
+        else {
+            all_coeff = false;
+        }
+    }
+    if (all_coeff) {
+        return PolyFromCoeff(sum);
+    }
+
+    if (k == 1) {
+        if (terms[0].owned == NULL) {
+            return PolyCloneTimesC(terms[0].p, terms[0].c);
+        }
+        Poly res = *terms[0].owned;
+        *terms[0].owned = PolyZero();
+        if (terms[0].c != 1) {
+            PolyMulByConstant(&res, terms[0].c);
+        }
+        return res;
+    }
+
+    LinCursor cur_inline[COMBINE_INLINE_TERMS];
+    LinTerm sub_inline[COMBINE_INLINE_TERMS];
+    LinCursor *cur = cur_inline;
+    LinTerm *sub = sub_inline;
+    if (k > COMBINE_INLINE_TERMS) {
+        cur = malloc(k * sizeof(LinCursor));
+        sub = malloc(k * sizeof(LinTerm));
+    }
+    Poly res = CombineMerge(k, terms, cur, sub);
+    if (k > COMBINE_INLINE_TERMS) {
+        free(cur);
+        free(sub);
+    }
+    return res;
+}
+
+static const Poly *Materialize(PolyExprGraph *g, PolyExpr e);
+
+/**
+ * Wylicza wartość węzła.
+ * Rozwija węzeł w kombinację liniową i sumuje jej składniki jednym
+ * scaleniem list jednomianów. Iloczyny, z których korzysta tylko ten
+ * węzeł, są wyliczane przez PolyMul(), a ich jednomiany są przenoszone
+ * do wyniku.
+ * @param g : wskaźnik na graf
+ * @param root : węzeł
+ * @return wartość węzła
+ */
+static Poly Compute(PolyExprGraph *g, PolyExpr root) {
+    ExprTerms t = {.terms = NULL, .count = 0, .size = 0, .constant = 0};
+    Flatten(g, root, root, 1, &t);
+
+    // wspólne podwyrażenia występujące kilka razy łączymy w jeden składnik
+    if (t.count > 1) {
+        qsort(t.terms, t.count, sizeof(ExprTerm), TermCmp);
+    }
+    unsigned int unique = 0;
+    for (unsigned int i = 0; i < t.count; i++) {
+        if (unique > 0 && t.terms[unique - 1].node == t.terms[i].node) {
+            t.terms[unique - 1].coeff += t.terms[i].coeff;
+        }
+        else {
+            t.terms[unique++] = t.terms[i];
+        }
+    }
+
+    LinTerm *terms = malloc((unique + 1) * sizeof(LinTerm));
+    Poly *owned = malloc((unique + 1) * sizeof(Poly));
+    unsigned int k = 0;
+    for (unsigned int i = 0; i < unique; i++) {
+        PolyExpr e = t.terms[i].node;
+        poly_coeff_t c = t.terms[i].coeff;
+        if (c == 0) {
+            continue;
+        }
+        if (g->nodes[e].kind == POLY_EXPR_MUL && NodeIsFusible(g, e, root)) {
+            const Poly *p = Materialize(g, g->nodes[e].a);
+            const Poly *q = Materialize(g, g->nodes[e].b);
+            owned[k] = PolyMul(p, q);
+            terms[k] = (LinTerm) {.p = &owned[k], .owned = &owned[k], .c = c};
+        }
+        else {
+            terms[k] = (LinTerm) {.p = Materialize(g, e), .owned = NULL,
+                                  .c = c};
+        }
+        k++;
+    }
+    if (t.constant != 0) {
+        owned[k] = PolyFromCoeff(t.constant);
+        terms[k] = (LinTerm) {.p = &owned[k], .owned = &owned[k], .c = 1};
+        k++;
+    }
+
+    Poly res = k == 0 ? PolyZero() : Combine(k, terms);
+    free(owned);
+    free(terms);
+    free(t.terms);
+    return res;
+}
+
+/**
+ * Zwraca wartość węzła, wyliczając ją, jeżeli jeszcze nie była wyliczona
+ * @param g : wskaźnik na graf
+ * @param e : węzeł
+ * @return wskaźnik na wartość węzła
+ */
+static const Poly *Materialize(PolyExprGraph *g, PolyExpr e) {
+    if (g->nodes[e].kind == POLY_EXPR_LEAF) {
+        return g->nodes[e].leaf;
+    }
+    if (!g->nodes[e].ready) {
+        Poly value = Compute(g, e);
+        g->nodes[e].value = value;
+        g->nodes[e].ready = true;
+    }
+    return &g->nodes[e].value;
+}
+
+Poly PolyExprEval(PolyExprGraph *g, PolyExpr e) {
+    const PolyExprNode *n = &g->nodes[e];
+    if (n->kind != POLY_EXPR_LEAF && !n->ready && n->uses == 0) {
+        // z wartości nie korzysta żaden inny węzeł, więc jej nie zapamiętujemy
+        return Compute(g, e);
+    }
+    return PolyClone(Materialize(g, e));
+}
@@ -0,0 +1,146 @@
+/** @file
+   Interfejs leniwych wyrażeń na wielomianach
+
+   @copyright Uniwersytet Warszawski
+   @date 2026-10-19
+*/
+
+#pragma once
+
+#include "poly.h"
+
+/**
+ * Rodzaj węzła wyrażenia
+ */
+typedef enum PolyExprKind {
+    POLY_EXPR_LEAF, ///< wielomian podany przez użytkownika
+    POLY_EXPR_CONST, ///< wielomian stały
+    POLY_EXPR_ADD, ///< suma dwóch wyrażeń
+    POLY_EXPR_MUL, ///< iloczyn dwóch wyrażeń
+    POLY_EXPR_SCALE ///< wyrażenie pomnożone przez stałą
+} PolyExprKind;
+
+/**
+ * Identyfikator wyrażenia (indeks węzła w grafie)
+ */
+typedef unsigned PolyExpr;
+
+/**
+ * Struktura węzła grafu wyrażeń
+ */
+typedef struct PolyExprNode {
+    PolyExprKind kind; ///< rodzaj węzła
+    PolyExpr a; ///< pierwszy argument
+    PolyExpr b; ///< drugi argument
+    poly_coeff_t c; ///< stała (dla @p POLY_EXPR_CONST i @p POLY_EXPR_SCALE)
+    const Poly *leaf; ///< wielomian (dla @p POLY_EXPR_LEAF)
+    unsigned int uses; ///< liczba węzłów korzystających z tego węzła
+    bool ready; ///< czy wartość węzła została już wyliczona?
+    Poly value; ///< wyliczona wartość węzła
+} PolyExprNode;
+
+/**
+ * Struktura grafu wyrażeń.
+ * Operacje nie wyliczają wyników, tylko dodają węzły do grafu; identyczne
+ * węzły są tworzone tylko raz. Wartość wyrażenia jest wyliczana dopiero
+ * przez PolyExprEval(), przy czym drzewa sum, różnic i iloczynów przez
+ * stałą są wyliczane jednym scaleniem list jednomianów, bez tworzenia
+ * wyników pośrednich. Iloczyny, z których korzysta tylko jeden węzeł,
+ * są wliczane do tego scalenia bez kopiowania ich jednomianów.
+ */
+typedef struct PolyExprGraph {
+    PolyExprNode *nodes; ///< węzły
+    unsigned int count; ///< liczba węzłów
+    unsigned int size; ///< rozmiar tablicy @p nodes
+    unsigned int *table; ///< tablica haszująca indeksów węzłów (+1, 0 = puste)
+    unsigned int table_size; ///< rozmiar tablicy @p table
+} PolyExprGraph;
+
+/**
+ * Zwraca pusty graf wyrażeń
+ * @return pusty graf
+ */
+static inline PolyExprGraph EmptyExprGraph() {
+    return (PolyExprGraph) {
+            .nodes = NULL, .count = 0, .size = 0, .table = NULL,
+            .table_size = 0
+    };
+}
+
+/**
+ * Usuwa graf wyrażeń wraz z wyliczonymi wartościami węzłów
+ * (bez wielomianów podanych przez użytkownika)
+ * @param[in] g : wskaźnik na graf
+ */
+void PolyExprGraphDestroy(PolyExprGraph *g);
+
+/**
+ * Tworzy wyrażenie będące wielomianem.
+ * Wielomian nie jest kopiowany i musi istnieć, dopóki istnieje graf.
+ * @param[in] g : wskaźnik na graf
+ * @param[in] p : wskaźnik na wielomian
+ * @return wyrażenie
+ */
+PolyExpr PolyExprLeaf(PolyExprGraph *g, const Poly *p);
+
+/**
+ * Tworzy wyrażenie będące stałą
+ * @param[in] g : wskaźnik na graf
+ * @param[in] c : stała
+ * @return wyrażenie
+ */
+PolyExpr PolyExprConst(PolyExprGraph *g, poly_coeff_t c);
+
+/**
+ * Tworzy wyrażenie `a + b`
+ * @param[in] g : wskaźnik na graf
+ * @param[in] a : wyrażenie
+ * @param[in] b : wyrażenie
+ * @return wyrażenie
+ */
+PolyExpr PolyExprAdd(PolyExprGraph *g, PolyExpr a, PolyExpr b);
+
+/**
+ * Tworzy wyrażenie `a - b`
+ * @param[in] g : wskaźnik na graf
+ * @param[in] a : wyrażenie
+ * @param[in] b : wyrażenie
+ * @return wyrażenie
+ */
+PolyExpr PolyExprSub(PolyExprGraph *g, PolyExpr a, PolyExpr b);
+
+/**
+ * Tworzy wyrażenie `a * b`
+ * @param[in] g : wskaźnik na graf
+ * @param[in] a : wyrażenie
+ * @param[in] b : wyrażenie
+ * @return wyrażenie
+ */
+PolyExpr PolyExprMul(PolyExprGraph *g, PolyExpr a, PolyExpr b);
+
+/**
+ * Tworzy wyrażenie `-a`
+ * @param[in] g : wskaźnik na graf
+ * @param[in] a : wyrażenie
+ * @return wyrażenie
+ */
+PolyExpr PolyExprNeg(PolyExprGraph *g, PolyExpr a);
+
+/**
+ * Tworzy wyrażenie `c * a`
+ * @param[in] g : wskaźnik na graf
+ * @param[in] a : wyrażenie
+ * @param[in] c : stała
+ * @return wyrażenie
+ */
+PolyExpr PolyExprScale(PolyExprGraph *g, PolyExpr a, poly_coeff_t c);
+
+/**
+ * Wylicza wartość wyrażenia.
+ * Wartości węzłów współdzielonych przez kilka wyrażeń są wyliczane raz
+ * i przechowywane w grafie.
+ * @param[in] g : wskaźnik na graf
+ * @param[in] e : wyrażenie
+ * @return wartość wyrażenia
+ */
+Poly PolyExprEval(PolyExprGraph *g, PolyExpr e);
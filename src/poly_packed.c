@@ -0,0 +1,521 @@
+/** @file
+   Implementacja zwartej reprezentacji wielomianów
+
+   @copyright Uniwersytet Warszawski
+   @date 2026-10-19
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "poly_packed.h"
+#include "poly_simd.h"
+
+/**
+ * Zapisuje jednomiany niestałego wielomianu pod indeksami od @p start,
+ * a jego współczynniki za ostatnim zajętym indeksem
+ * @param p : wskaźnik na niestały wielomian
+ * @param pp : wskaźnik na budowany wielomian w zwartej postaci
+ * @param start : indeks pierwszego jednomianu
+ * @param end : wskaźnik na pierwszy wolny indeks
+ */
+static void PackRun(const Poly *p, PolyPacked *pp, uint32_t start,
+                    uint32_t *end) {
+    uint32_t i = start;
+    for (Mono *p_head = p->head; p_head != NULL; p_head = p_head->next, i++) {
+        pp->exps[i] = (uint32_t) p_head->exp |
+                      (p_head->next == NULL ? PACKED_RUN_END : 0);
+        if (PolyIsCoeff(&p_head->p)) {
+            pp->child[i] = PACKED_NO_CHILD;
+            pp->coeffs[i] = p_head->p.coeff;
+        }
+        else {
+            pp->child[i] = *end;
+            pp->coeffs[i] = 0;
+            *end += (uint32_t) PolyLen(&p_head->p);
+            PackRun(&p_head->p, pp, pp->child[i], end);
+        }
+    }
+}
+
+PolyPacked PolyPack(const Poly *p) {
+    PolyPacked pp = {
+            .coeff = p->coeff, .exps = NULL, .child = NULL, .coeffs = NULL,
+            .count = 0, .root = 0
+    };
+    if (PolyIsCoeff(p)) {
+        return pp;
+    }
+    pp.count = (uint32_t) PolyTermCount(p);
+    pp.exps = malloc(pp.count * sizeof(uint32_t));
+    pp.child = malloc(pp.count * sizeof(uint32_t));
+    pp.coeffs = malloc(pp.count * sizeof(poly_coeff_t));
+    uint32_t end = (uint32_t) PolyLen(p);
+    PackRun(p, &pp, 0, &end);
+    return pp;
+}
+
+/**
+ * Odtwarza wielomian, którego jednomiany zaczynają się pod indeksem
+ * @p start
+ * @param pp : wskaźnik na wielomian w zwartej postaci
+ * @param start : indeks pierwszego jednomianu
+ * @return wielomian
+ */
+static Poly UnpackRun(const PolyPacked *pp, uint32_t start) {
+    PolyBuilder builder = EmptyPolyBuilder();
+    for (uint32_t i = start;; i++) {
+        Poly t = pp->child[i] != PACKED_NO_CHILD
+                 ? UnpackRun(pp, pp->child[i])
+                 : PolyFromCoeff(pp->coeffs[i]);
+        PolyBuilderAppend(&builder, &t, PackedExp(pp, i));
+        if (PackedIsRunEnd(pp, i)) {
+            break;
+        }
+    }
+    return PolyBuilderFinish(&builder);
+}
+
+Poly PolyUnpack(const PolyPacked *pp) {
+    if (PolyPackedIsCoeff(pp)) {
+        return PolyFromCoeff(pp->coeff);
+    }
+    return UnpackRun(pp, pp->root);
+}
+
+void PolyPackedDestroy(PolyPacked *pp) {
+    free(pp->exps);
+    free(pp->child);
+    free(pp->coeffs);
+    *pp = (PolyPacked) {
+            .coeff = 0, .exps = NULL, .child = NULL, .coeffs = NULL,
+            .count = 0, .root = 0
+    };
+}
+
+/**
+ * Wylicza wartość wielomianu, którego jednomiany zaczynają się pod
+ * indeksem @p start
+ * @param pp : wskaźnik na wielomian w zwartej postaci
+ * @param start : indeks pierwszego jednomianu
+ * @param var_idx : indeks zmiennej głównej tego wielomianu
+ * @param n : wymiar punktu
+ * @param x : współrzędne punktu
+ * @return wartość wielomianu
+ */
+static poly_coeff_t AtRun(const PolyPacked *pp, uint32_t start,
+                          unsigned var_idx, unsigned n,
+                          const poly_coeff_t x[]) {
+    poly_coeff_t base = var_idx < n ? x[var_idx] : 0;
+    poly_coeff_t value = 0;
+    poly_coeff_t pow = 1;
+    poly_exp_t prev = 0;
+    for (uint32_t i = start;; i++) {
+        poly_exp_t e = PackedExp(pp, i);
+        pow *= ipow(base, e - prev);
+        prev = e;
+        if (pow == 0 && base == 0) {
+            // kolejne jednomiany też się zerują
+            break;
+        }
+        if (pp->child[i] != PACKED_NO_CHILD) {
+            value += pow * AtRun(pp, pp->child[i], var_idx + 1, n, x);
+        }
+        else {
+            value += pow * pp->coeffs[i];
+        }
+        if (PackedIsRunEnd(pp, i)) {
+            break;
+        }
+    }
+    return value;
+}
+
+poly_coeff_t PolyPackedAt(const PolyPacked *pp, unsigned n,
+                          const poly_coeff_t x[]) {
+    if (PolyPackedIsCoeff(pp)) {
+        return pp->coeff;
+    }
+    return AtRun(pp, pp->root, 0, n, x);
+}
+
+/**
+ * Wynik budowy wielomianu: stała albo początek jednomianów
+ */
+typedef struct PackedValue {
+    uint32_t run; ///< początek jednomianów lub @p PACKED_NO_CHILD dla stałej
+    poly_coeff_t coeff; ///< wartość stałej
+} PackedValue;
+
+/**
+ * Wartość pola `child` jednomianu usuniętego przez CompactRun()
+ */
+#define PACKED_DEAD_SLOT (PACKED_NO_CHILD - 1)
+
+/**
+ * Usuwa w miejscu zerowe współczynniki stałe z wielomianu zaczynającego
+ * się pod indeksem @p start i z jego współczynników. Pozostawione
+ * jednomiany są przesuwane na początek fragmentu zajmowanego przez
+ * wielomian, a zwolnione miejsca oznaczane jako @p PACKED_DEAD_SLOT.
+ * Wielomian pusty lub postaci `c * x^0` jest zamieniany na stałą.
+ * @param pp : wskaźnik na wielomian w zwartej postaci
+ * @param start : indeks pierwszego jednomianu
+ * @return wielomian po usunięciu zer
+ */
+static PackedValue CompactRun(PolyPacked *pp, uint32_t start) {
+    uint32_t end = start;
+    bool leaves = true;
+    for (;; end++) {
+        leaves = leaves && pp->child[end] == PACKED_NO_CHILD;
+        if (PackedIsRunEnd(pp, end)) {
+            break;
+        }
+    }
+    pp->exps[end] &= PACKED_EXP_MASK;
+
+    uint32_t k;
+    if (leaves) {
+        k = (uint32_t) CoeffCompact(pp->exps + start, pp->coeffs + start,
+                                    end - start + 1);
+    }
+    else {
+        k = 0;
+        for (uint32_t i = start; i <= end; i++) {
+            uint32_t child = pp->child[i];
+            poly_coeff_t coeff = pp->coeffs[i];
+            if (child != PACKED_NO_CHILD) {
+                PackedValue v = CompactRun(pp, child);
+                child = v.run;
+                coeff = v.coeff;
+            }
+            if (child == PACKED_NO_CHILD && coeff == 0) {
+                continue;
+            }
+            pp->exps[start + k] = pp->exps[i];
+            pp->child[start + k] = child;
+            pp->coeffs[start + k] = coeff;
+            k++;
+        }
+    }
+    for (uint32_t i = start + k; i <= end; i++) {
+        pp->child[i] = PACKED_DEAD_SLOT;
+    }
+
+    if (k == 0) {
+        return (PackedValue) {.run = PACKED_NO_CHILD, .coeff = 0};
+    }
+    if (k == 1 && pp->exps[start] == 0 &&
+        pp->child[start] == PACKED_NO_CHILD) {
+        pp->child[start] = PACKED_DEAD_SLOT;
+        return (PackedValue) {.run = PACKED_NO_CHILD,
+                              .coeff = pp->coeffs[start]};
+    }
+    pp->exps[start + k - 1] |= PACKED_RUN_END;
+    return (PackedValue) {.run = start, .coeff = 0};
+}
+
+/**
+ * Usuwa z tablic miejsca oznaczone jako @p PACKED_DEAD_SLOT, poprawiając
+ * indeksy współczynników i początku wielomianu
+ * @param pp : wskaźnik na wielomian w zwartej postaci
+ */
+static void RemoveDeadSlots(PolyPacked *pp) {
+    uint32_t *index = malloc(pp->count * sizeof(uint32_t));
+    uint32_t k = 0;
+    for (uint32_t i = 0; i < pp->count; i++) {
+        index[i] = k;
+        if (pp->child[i] != PACKED_DEAD_SLOT) {
+            pp->exps[k] = pp->exps[i];
+            pp->child[k] = pp->child[i];
+            pp->coeffs[k] = pp->coeffs[i];
+            k++;
+        }
+    }
+    for (uint32_t i = 0; i < k; i++) {
+        if (pp->child[i] != PACKED_NO_CHILD) {
+            pp->child[i] = index[pp->child[i]];
+        }
+    }
+    pp->root = index[pp->root];
+    pp->count = k;
+    free(index);
+}
+
+void PolyPackedScale(PolyPacked *pp, poly_coeff_t c) {
+    if (PolyPackedIsCoeff(pp)) {
+        pp->coeff *= c;
+        return;
+    }
+    if (c == 0) {
+        PolyPackedDestroy(pp);
+        return;
+    }
+    // współczynniki niestałe są zerami, więc mnożymy całą tablicę naraz;
+    // nieparzysta stała jest odwracalna modulo 2^64, więc wtedy żaden
+    // niezerowy współczynnik się nie wyzeruje
+    if (CoeffScale(pp->coeffs, pp->coeffs, pp->count, c) == 0) {
+        return;
+    }
+    PackedValue v = CompactRun(pp, pp->root);
+    if (v.run == PACKED_NO_CHILD) {
+        PolyPackedDestroy(pp);
+        pp->coeff = v.coeff;
+        return;
+    }
+    RemoveDeadSlots(pp);
+}
+
+void PolyPackedNeg(PolyPacked *pp) {
+    if (PolyPackedIsCoeff(pp)) {
+        pp->coeff = -pp->coeff;
+        return;
+    }
+    CoeffNeg(pp->coeffs, pp->coeffs, pp->count);
+}
+
+/**
+ * Struktura dynamicznie powiększanych tablic jednomianów w zwartej postaci
+ */
+typedef struct PackedBuffer {
+    uint32_t *exps; ///< wykładniki
+    uint32_t *child; ///< początki wielomianów - współczynników
+    poly_coeff_t *coeffs; ///< współczynniki stałe
+    uint32_t count; ///< liczba jednomianów
+    uint32_t size; ///< rozmiar tablic
+} PackedBuffer;
+
+/**
+ * Zapewnia miejsce na kolejne jednomiany
+ * @param buf : wskaźnik na tablice
+ * @param extra : liczba dodawanych jednomianów
+ */
+static void BufferReserve(PackedBuffer *buf, uint32_t extra) {
+    if (buf->count + extra <= buf->size) {
+        return;
+    }
+    while (buf->count + extra > buf->size) {
+        buf->size = buf->size == 0 ? 16 : 2 * buf->size;
+    }
+    buf->exps = realloc(buf->exps, buf->size * sizeof(uint32_t));
+    buf->child = realloc(buf->child, buf->size * sizeof(uint32_t));
+    buf->coeffs = realloc(buf->coeffs, buf->size * sizeof(poly_coeff_t));
+}
+
+/**
+ * Dodaje jednomian na koniec tablic
+ * @param buf : wskaźnik na tablice
+ * @param e : wykładnik
+ * @param child : początek współczynnika lub @p PACKED_NO_CHILD
+ * @param c : współczynnik stały
+ */
+static void BufferPush(PackedBuffer *buf, poly_exp_t e, uint32_t child,
+                       poly_coeff_t c) {
+    BufferReserve(buf, 1);
+    buf->exps[buf->count] = (uint32_t) e;
+    buf->child[buf->count] = child;
+    buf->coeffs[buf->count] = c;
+    buf->count++;
+}
+
+/**
+ * Przenosi jednomiany zebrane na stosie od indeksu @p base na koniec
+ * wyniku, zamieniając wielomian pusty lub postaci `c * x^0` na stałą
+ * @param stack : wskaźnik na stos jednomianów
+ * @param base : indeks pierwszego jednomianu budowanego wielomianu na stosie
+ * @param out : wskaźnik na tablice wyniku
+ * @return zbudowany wielomian
+ */
+static PackedValue FlushRun(PackedBuffer *stack, uint32_t base,
+                            PackedBuffer *out) {
+    uint32_t len = stack->count - base;
+    if (len == 0) {
+        return (PackedValue) {.run = PACKED_NO_CHILD, .coeff = 0};
+    }
+    if (len == 1 && stack->exps[base] == 0 &&
+        stack->child[base] == PACKED_NO_CHILD) {
+        stack->count = base;
+        return (PackedValue) {.run = PACKED_NO_CHILD,
+                              .coeff = stack->coeffs[base]};
+    }
+    BufferReserve(out, len);
+    uint32_t start = out->count;
+    memcpy(out->exps + start, stack->exps + base, len * sizeof(uint32_t));
+    memcpy(out->child + start, stack->child + base, len * sizeof(uint32_t));
+    memcpy(out->coeffs + start, stack->coeffs + base,
+           len * sizeof(poly_coeff_t));
+    out->exps[start + len - 1] |= PACKED_RUN_END;
+    out->count += len;
+    stack->count = base;
+    return (PackedValue) {.run = start, .coeff = 0};
+}
+
+/**
+ * Dodaje jednomian o współczynniku @p v na stos
+ * @param stack : wskaźnik na stos jednomianów
+ * @param e : wykładnik
+ * @param v : współczynnik
+ */
+static void PushValue(PackedBuffer *stack, poly_exp_t e, PackedValue v) {
+    if (v.run == PACKED_NO_CHILD && v.coeff == 0) {
+        return;
+    }
+    BufferPush(stack, e, v.run, v.run == PACKED_NO_CHILD ? v.coeff : 0);
+}
+
+/**
+ * Kopiuje wielomian (w kolejności: najpierw współczynniki, potem
+ * jednomiany wielomianu)
+ * @param src : wskaźnik na wielomian źródłowy
+ * @param run : początek kopiowanych jednomianów
+ * @param stack : wskaźnik na stos jednomianów
+ * @param out : wskaźnik na tablice wyniku
+ * @return kopia
+ */
+static PackedValue CopyRun(const PolyPacked *src, uint32_t run,
+                           PackedBuffer *stack, PackedBuffer *out) {
+    uint32_t base = stack->count;
+    for (uint32_t i = run;; i++) {
+        PackedValue v = {.run = PACKED_NO_CHILD, .coeff = src->coeffs[i]};
+        if (src->child[i] != PACKED_NO_CHILD) {
+            v = CopyRun(src, src->child[i], stack, out);
+        }
+        PushValue(stack, PackedExp(src, i), v);
+        if (PackedIsRunEnd(src, i)) {
+            break;
+        }
+    }
+    return FlushRun(stack, base, out);
+}
+
+/**
+ * Dodaje dwa wielomiany, z których każdy jest stałą albo ciągiem
+ * jednomianów
+ * @param a : wskaźnik na pierwszy wielomian w zwartej postaci
+ * @param va : pierwszy składnik
+ * @param b : wskaźnik na drugi wielomian w zwartej postaci
+ * @param vb : drugi składnik
+ * @param stack : wskaźnik na stos jednomianów
+ * @param out : wskaźnik na tablice wyniku
+ * @return suma
+ */
+static PackedValue AddRuns(const PolyPacked *a, PackedValue va,
+                           const PolyPacked *b, PackedValue vb,
+                           PackedBuffer *stack, PackedBuffer *out) {
+    if (va.run == PACKED_NO_CHILD && vb.run == PACKED_NO_CHILD) {
+        return (PackedValue) {.run = PACKED_NO_CHILD,
+                              .coeff = va.coeff + vb.coeff};
+    }
+    if (va.run == PACKED_NO_CHILD && va.coeff == 0) {
+        return CopyRun(b, vb.run, stack, out);
+    }
+    if (vb.run == PACKED_NO_CHILD && vb.coeff == 0) {
+        return CopyRun(a, va.run, stack, out);
+    }
+    // niezerową stałą traktujemy jak wielomian z jednym jednomianem c * x^0
+    uint32_t const_exp = PACKED_RUN_END;
+    uint32_t const_child = PACKED_NO_CHILD;
+    PolyPacked const_poly = {
+            .coeff = 0, .exps = &const_exp, .child = &const_child,
+            .coeffs = NULL, .count = 1, .root = 0
+    };
+    if (va.run == PACKED_NO_CHILD) {
+        const_poly.coeffs = &va.coeff;
+        a = &const_poly;
+        va.run = 0;
+    }
+    else if (vb.run == PACKED_NO_CHILD) {
+        const_poly.coeffs = &vb.coeff;
+        b = &const_poly;
+        vb.run = 0;
+    }
+
+    uint32_t base = stack->count;
+    uint32_t i = va.run, j = vb.run;
+    bool a_done = false, b_done = false;
+    while (!a_done || !b_done) {
+        poly_exp_t ea = a_done ? 0 : PackedExp(a, i);
+        poly_exp_t eb = b_done ? 0 : PackedExp(b, j);
+        bool a_end = !a_done && PackedIsRunEnd(a, i);
+        bool b_end = !b_done && PackedIsRunEnd(b, j);
+        if (!a_done && !b_done && ea == eb) {
+            if (a->child[i] == PACKED_NO_CHILD &&
+                b->child[j] == PACKED_NO_CHILD) {
+                // ciąg jednomianów o stałych współczynnikach i tych samych
+                // wykładnikach dodajemy wektorowo
+                uint32_t n = a->count - i < b->count - j ? a->count - i
+                                                         : b->count - j;
+                BufferReserve(stack, n);
+                uint32_t pos = stack->count;
+                size_t k = CoeffAddAligned(
+                        a->exps + i, a->child + i, a->coeffs + i,
+                        b->exps + j, b->child + j, b->coeffs + j, n,
+                        stack->exps + pos, stack->coeffs + pos);
+                a_end = PackedIsRunEnd(a, i + k - 1);
+                b_end = PackedIsRunEnd(b, j + k - 1);
+                i += k;
+                j += k;
+                k = CoeffCompact(stack->exps + pos, stack->coeffs + pos, k);
+                for (size_t l = 0; l < k; l++) {
+                    stack->child[pos + l] = PACKED_NO_CHILD;
+                }
+                stack->count += k;
+                a_done = a_end;
+                b_done = b_end;
+                continue;
+            }
+            PackedValue ca = {.run = a->child[i], .coeff = a->coeffs[i]};
+            PackedValue cb = {.run = b->child[j], .coeff = b->coeffs[j]};
+            PushValue(stack, ea, AddRuns(a, ca, b, cb, stack, out));
+            i++;
+            j++;
+        }
+        else if (b_done || (!a_done && ea < eb)) {
+            PackedValue v = {.run = PACKED_NO_CHILD, .coeff = a->coeffs[i]};
+            if (a->child[i] != PACKED_NO_CHILD) {
+                v = CopyRun(a, a->child[i], stack, out);
+            }
+            PushValue(stack, ea, v);
+            i++;
+            b_end = b_done;
+        }
+        else {
+            PackedValue v = {.run = PACKED_NO_CHILD, .coeff = b->coeffs[j]};
+            if (b->child[j] != PACKED_NO_CHILD) {
+                v = CopyRun(b, b->child[j], stack, out);
+            }
+            PushValue(stack, eb, v);
+            j++;
+            a_end = a_done;
+        }
+        a_done = a_done || a_end;
+        b_done = b_done || b_end;
+    }
+    return FlushRun(stack, base, out);
+}
+
+PolyPacked PolyPackedAdd(const PolyPacked *a, const PolyPacked *b) {
+    PackedValue va = {.run = PolyPackedIsCoeff(a) ? PACKED_NO_CHILD : a->root,
+                      .coeff = a->coeff};
+    PackedValue vb = {.run = PolyPackedIsCoeff(b) ? PACKED_NO_CHILD : b->root,
+                      .coeff = b->coeff};
+    PackedBuffer stack = {
+            .exps = NULL, .child = NULL, .coeffs = NULL, .count = 0, .size = 0
+    };
+    PackedBuffer out = stack;
+    PackedValue res = AddRuns(a, va, b, vb, &stack, &out);
+    free(stack.exps);
+    free(stack.child);
+    free(stack.coeffs);
+    if (res.run == PACKED_NO_CHILD) {
+        free(out.exps);
+        free(out.child);
+        free(out.coeffs);
+        return (PolyPacked) {
+                .coeff = res.coeff, .exps = NULL, .child = NULL,
+                .coeffs = NULL, .count = 0, .root = 0
+        };
+    }
+    return (PolyPacked) {
+            .coeff = 0, .exps = out.exps, .child = out.child,
+            .coeffs = out.coeffs, .count = out.count, .root = res.run
+    };
+}
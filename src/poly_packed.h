@@ -0,0 +1,142 @@
+/** @file
+   Interfejs zwartej reprezentacji wielomianów
+
+   @copyright Uniwersytet Warszawski
+   @date 2026-10-19
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include "poly.h"
+
+/**
+ * Bit wykładnika oznaczający ostatni jednomian wielomianu
+ */
+#define PACKED_RUN_END 0x80000000u
+
+/**
+ * Maska wyodrębniająca wykładnik
+ */
+#define PACKED_EXP_MASK 0x7fffffffu
+
+/**
+ * Wartość pola `child` jednomianu o stałym współczynniku
+ */
+#define PACKED_NO_CHILD UINT32_MAX
+
+/**
+ * Struktura przechowująca wielomian w zwartej postaci.
+ * Jednomiany wszystkich wielomianów wchodzących w skład wielomianu leżą
+ * w trzech równoległych tablicach. Jednomiany jednego wielomianu zajmują
+ * spójny fragment tablic, a ostatni z nich ma ustawiony bit
+ * @p PACKED_RUN_END. Współczynnik jednomianu jest stałą z tablicy
+ * @p coeffs, jeżeli `child` jest równe @p PACKED_NO_CHILD, a w przeciwnym
+ * razie wielomianem zaczynającym się pod indeksem `child`. Jeden jednomian
+ * zajmuje 16 bajtów i nie wymaga osobnej alokacji.
+ */
+typedef struct PolyPacked {
+    poly_coeff_t coeff; ///< wartość wielomianu stałego (gdy count = 0)
+    uint32_t *exps; ///< wykładniki, z bitem @p PACKED_RUN_END
+    uint32_t *child; ///< początki wielomianów - współczynników
+    poly_coeff_t *coeffs; ///< współczynniki stałe (0 dla niestałych)
+    uint32_t count; ///< liczba jednomianów
+    uint32_t root; ///< indeks pierwszego jednomianu całego wielomianu
+} PolyPacked;
+
+/**
+ * Zwraca wykładnik jednomianu
+ * @param[in] pp : wskaźnik na wielomian
+ * @param[in] i : indeks jednomianu
+ * @return wykładnik
+ */
+static inline poly_exp_t PackedExp(const PolyPacked *pp, uint32_t i) {
+    return (poly_exp_t) (pp->exps[i] & PACKED_EXP_MASK);
+}
+
+/**
+ * Sprawdza, czy jednomian jest ostatnim jednomianem swojego wielomianu
+ * @param[in] pp : wskaźnik na wielomian
+ * @param[in] i : indeks jednomianu
+ * @return czy jest to ostatni jednomian?
+ */
+static inline bool PackedIsRunEnd(const PolyPacked *pp, uint32_t i) {
+    return (pp->exps[i] & PACKED_RUN_END) != 0;
+}
+
+/**
+ * Sprawdza, czy wielomian w zwartej postaci jest stały
+ * @param[in] pp : wskaźnik na wielomian
+ * @return czy wielomian jest stały?
+ */
+static inline bool PolyPackedIsCoeff(const PolyPacked *pp) {
+    return pp->count == 0;
+}
+
+/**
+ * Tworzy zwartą kopię wielomianu
+ * @param[in] p : wielomian
+ * @return wielomian w zwartej postaci
+ */
+PolyPacked PolyPack(const Poly *p);
+
+/**
+ * Odtwarza wielomian ze zwartej postaci
+ * @param[in] pp : wskaźnik na wielomian w zwartej postaci
+ * @return wielomian
+ */
+Poly PolyUnpack(const PolyPacked *pp);
+
+/**
+ * Usuwa wielomian w zwartej postaci z pamięci
+ * @param[in] pp : wskaźnik na wielomian
+ */
+void PolyPackedDestroy(PolyPacked *pp);
+
+/**
+ * Zwraca liczbę bajtów zajmowanych przez jednomiany wielomianu
+ * @param[in] pp : wskaźnik na wielomian
+ * @return rozmiar w bajtach
+ */
+static inline size_t PolyPackedBytes(const PolyPacked *pp) {
+    return (size_t) pp->count *
+           (2 * sizeof(uint32_t) + sizeof(poly_coeff_t));
+}
+
+/**
+ * Wylicza wartość wielomianu w punkcie (bez alokacji pamięci).
+ * Pod zmienne o indeksach >= @p n podstawiane jest zero.
+ * Funkcja tylko odczytuje wielomian, więc może być wywoływana
+ * równocześnie z wielu wątków dla tego samego wielomianu.
+ * @param[in] pp : wskaźnik na wielomian
+ * @param[in] n : wymiar punktu
+ * @param[in] x : współrzędne punktu
+ * @return wartość wielomianu
+ */
+poly_coeff_t PolyPackedAt(const PolyPacked *pp, unsigned n,
+                          const poly_coeff_t x[]);
+
+/**
+ * Mnoży wielomian w zwartej postaci przez stałą (modyfikując go).
+ * Współczynniki są przetwarzane wektorowo.
+ * @param[in] pp : wskaźnik na wielomian
+ * @param[in] c : stała
+ */
+void PolyPackedScale(PolyPacked *pp, poly_coeff_t c);
+
+/**
+ * Zamienia wielomian w zwartej postaci na przeciwny (modyfikując go).
+ * Współczynniki są przetwarzane wektorowo.
+ * @param[in] pp : wskaźnik na wielomian
+ */
+void PolyPackedNeg(PolyPacked *pp);
+
+/**
+ * Dodaje dwa wielomiany w zwartej postaci.
+ * Fragmenty o tych samych wykładnikach i stałych współczynnikach są
+ * dodawane wektorowo.
+ * @param[in] a : wskaźnik na wielomian
+ * @param[in] b : wskaźnik na wielomian
+ * @return `a + b`
+ */
+PolyPacked PolyPackedAdd(const PolyPacked *a, const PolyPacked *b);
@@ -0,0 +1,363 @@
+/** @file
+   Implementacja wektorowych operacji na tablicach współczynników
+
+   @copyright Uniwersytet Warszawski
+   @date 2026-10-19
+*/
+
+#include "poly_simd.h"
+
+#if defined(__GNUC__) && defined(__x86_64__) && __SIZEOF_LONG__ == 8
+/**
+ * Czy dostępne są wersje operacji dla x86-64
+ */
+#define POLY_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+/**
+ * Struktura zestawu operacji na współczynnikach
+ */
+typedef struct CoeffKernels {
+    const char *name; ///< nazwa zestawu
+    /** mnożenie przez stałą */
+    size_t (*scale)(poly_coeff_t *, const poly_coeff_t *, size_t,
+                    poly_coeff_t);
+    /** negacja */
+    void (*neg)(poly_coeff_t *, const poly_coeff_t *, size_t);
+    /** dodawanie jednomianów o tych samych wykładnikach */
+    size_t (*add_aligned)(const uint32_t *, const uint32_t *,
+                          const poly_coeff_t *, const uint32_t *,
+                          const uint32_t *, const poly_coeff_t *, size_t,
+                          uint32_t *, poly_coeff_t *);
+    /** usuwanie zerowych współczynników */
+    size_t (*compact)(uint32_t *, poly_coeff_t *, size_t);
+} CoeffKernels;
+
+/**
+ * Mnoży dwie liczby modulo 2^64
+ * @param a : liczba
+ * @param b : liczba
+ * @return a * b
+ */
+static inline poly_coeff_t WrapMul(poly_coeff_t a, poly_coeff_t b) {
+    return (poly_coeff_t) ((unsigned long) a * (unsigned long) b);
+}
+
+/**
+ * Dodaje dwie liczby modulo 2^64
+ * @param a : liczba
+ * @param b : liczba
+ * @return a + b
+ */
+static inline poly_coeff_t WrapAdd(poly_coeff_t a, poly_coeff_t b) {
+    return (poly_coeff_t) ((unsigned long) a + (unsigned long) b);
+}
+
+/**
+ * Przenośna wersja CoeffScale()
+ */
+static size_t ScaleScalar(poly_coeff_t *dst, const poly_coeff_t *src,
+                          size_t n, poly_coeff_t c) {
+    size_t zeroed = 0;
+    for (size_t i = 0; i < n; i++) {
+        poly_coeff_t v = WrapMul(src[i], c);
+        zeroed += src[i] != 0 && v == 0;
+        dst[i] = v;
+    }
+    return zeroed;
+}
+
+/**
+ * Przenośna wersja CoeffNeg()
+ */
+static void NegScalar(poly_coeff_t *dst, const poly_coeff_t *src, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = (poly_coeff_t) (0ul - (unsigned long) src[i]);
+    }
+}
+
+/**
+ * Dodaje jednomiany od indeksu @p k, jak CoeffAddAligned()
+ * @return indeks pierwszego niedodanego jednomianu
+ */
+static size_t AddAlignedTail(const uint32_t *ea, const uint32_t *ka,
+                             const poly_coeff_t *ca, const uint32_t *eb,
+                             const uint32_t *kb, const poly_coeff_t *cb,
+                             size_t n, uint32_t *eo, poly_coeff_t *co,
+                             size_t k) {
+    while (k < n && ka[k] == PACKED_NO_CHILD && kb[k] == PACKED_NO_CHILD &&
+           ((ea[k] ^ eb[k]) & PACKED_EXP_MASK) == 0) {
+        eo[k] = ea[k] & PACKED_EXP_MASK;
+        co[k] = WrapAdd(ca[k], cb[k]);
+        k++;
+        if ((ea[k - 1] | eb[k - 1]) & PACKED_RUN_END) {
+            break;
+        }
+    }
+    return k;
+}
+
+/**
+ * Przenośna wersja CoeffAddAligned()
+ */
+static size_t AddAlignedScalar(const uint32_t *ea, const uint32_t *ka,
+                               const poly_coeff_t *ca, const uint32_t *eb,
+                               const uint32_t *kb, const poly_coeff_t *cb,
+                               size_t n, uint32_t *eo, poly_coeff_t *co) {
+    return AddAlignedTail(ea, ka, ca, eb, kb, cb, n, eo, co, 0);
+}
+
+/**
+ * Usuwa zera od indeksu @p i, jak CoeffCompact()
+ * @return liczba pozostawionych jednomianów
+ */
+static size_t CompactTail(uint32_t *exps, poly_coeff_t *coeffs, size_t n,
+                          size_t i, size_t k) {
+    for (; i < n; i++) {
+        if (coeffs[i] != 0) {
+            exps[k] = exps[i];
+            coeffs[k] = coeffs[i];
+            k++;
+        }
+    }
+    return k;
+}
+
+/**
+ * Przenośna wersja CoeffCompact()
+ */
+static size_t CompactScalar(uint32_t *exps, poly_coeff_t *coeffs, size_t n) {
+    return CompactTail(exps, coeffs, n, 0, 0);
+}
+
+/**
+ * Przenośny zestaw operacji
+ */
+static const CoeffKernels scalar_kernels = {
+        .name = "scalar", .scale = ScaleScalar, .neg = NegScalar,
+        .add_aligned = AddAlignedScalar, .compact = CompactScalar
+};
+
+#ifdef POLY_SIMD_X86
+
+/**
+ * Wersja AVX2 CoeffScale()
+ */
+__attribute__((target("avx2")))
+static size_t ScaleAvx2(poly_coeff_t *dst, const poly_coeff_t *src, size_t n,
+                        poly_coeff_t c) {
+    // AVX2 nie ma mnożenia liczb 64-bitowych, więc składamy je
+    // z trzech mnożeń połówek 32-bitowych
+    __m256i vc = _mm256_set1_epi64x(c);
+    __m256i vc_hi = _mm256_srli_epi64(vc, 32);
+    __m256i zero = _mm256_setzero_si256();
+    size_t i = 0, zeroed = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i *) (src + i));
+        __m256i lo = _mm256_mul_epu32(v, vc);
+        __m256i cross = _mm256_add_epi64(
+                _mm256_mul_epu32(_mm256_srli_epi64(v, 32), vc),
+                _mm256_mul_epu32(v, vc_hi));
+        __m256i res = _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+        __m256i became_zero = _mm256_andnot_si256(
+                _mm256_cmpeq_epi64(v, zero), _mm256_cmpeq_epi64(res, zero));
+        zeroed += (size_t) __builtin_popcount(
+                _mm256_movemask_pd(_mm256_castsi256_pd(became_zero)));
+        _mm256_storeu_si256((__m256i *) (dst + i), res);
+    }
+    return zeroed + ScaleScalar(dst + i, src + i, n - i, c);
+}
+
+/**
+ * Wersja AVX2 CoeffNeg()
+ */
+__attribute__((target("avx2")))
+static void NegAvx2(poly_coeff_t *dst, const poly_coeff_t *src, size_t n) {
+    __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i *) (src + i));
+        _mm256_storeu_si256((__m256i *) (dst + i), _mm256_sub_epi64(zero, v));
+    }
+    NegScalar(dst + i, src + i, n - i);
+}
+
+/**
+ * Wersja AVX2 CoeffAddAligned() (używana też z AVX-512)
+ */
+__attribute__((target("avx2")))
+static size_t AddAlignedAvx2(const uint32_t *ea, const uint32_t *ka,
+                             const poly_coeff_t *ca, const uint32_t *eb,
+                             const uint32_t *kb, const poly_coeff_t *cb,
+                             size_t n, uint32_t *eo, poly_coeff_t *co) {
+    const __m128i exp_mask = _mm_set1_epi32((int) PACKED_EXP_MASK);
+    const __m128i end_bit = _mm_set1_epi32((int) PACKED_RUN_END);
+    const __m128i no_child = _mm_set1_epi32(-1);
+    size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        __m128i va = _mm_loadu_si128((const __m128i *) (ea + k));
+        __m128i vb = _mm_loadu_si128((const __m128i *) (eb + k));
+        __m128i leaves = _mm_and_si128(
+                _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) (ka + k)),
+                                no_child),
+                _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) (kb + k)),
+                                no_child));
+        __m128i diff = _mm_and_si128(_mm_xor_si128(va, vb), exp_mask);
+        __m128i ends = _mm_and_si128(_mm_or_si128(va, vb), end_bit);
+        // cztery jednomiany liściowe o równych wykładnikach wewnątrz
+        // obu wielomianów
+        if (_mm_movemask_epi8(leaves) != 0xffff ||
+            !_mm_testz_si128(_mm_or_si128(diff, ends), _mm_set1_epi32(-1))) {
+            break;
+        }
+        _mm_storeu_si128((__m128i *) (eo + k), _mm_and_si128(va, exp_mask));
+        __m256i sum = _mm256_add_epi64(
+                _mm256_loadu_si256((const __m256i *) (ca + k)),
+                _mm256_loadu_si256((const __m256i *) (cb + k)));
+        _mm256_storeu_si256((__m256i *) (co + k), sum);
+    }
+    return AddAlignedTail(ea, ka, ca, eb, kb, cb, n, eo, co, k);
+}
+
+/**
+ * Wersja AVX2 CoeffCompact()
+ */
+__attribute__((target("avx2")))
+static size_t CompactAvx2(uint32_t *exps, poly_coeff_t *coeffs, size_t n) {
+    __m256i zero = _mm256_setzero_si256();
+    size_t i = 0, k = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i *) (coeffs + i));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi64(v, zero)) != 0) {
+            k = CompactTail(exps, coeffs, i + 4, i, k);
+        }
+        else if (k != i) {
+            _mm256_storeu_si256((__m256i *) (coeffs + k), v);
+            for (size_t j = 0; j < 4; j++) {
+                exps[k + j] = exps[i + j];
+            }
+            k += 4;
+        }
+        else {
+            k += 4;
+        }
+    }
+    return CompactTail(exps, coeffs, n, i, k);
+}
+
+/**
+ * Zestaw operacji AVX2
+ */
+static const CoeffKernels avx2_kernels = {
+        .name = "avx2", .scale = ScaleAvx2, .neg = NegAvx2,
+        .add_aligned = AddAlignedAvx2, .compact = CompactAvx2
+};
+
+/**
+ * Wersja AVX-512 CoeffScale()
+ */
+__attribute__((target("avx512f,avx512dq")))
+static size_t ScaleAvx512(poly_coeff_t *dst, const poly_coeff_t *src,
+                          size_t n, poly_coeff_t c) {
+    __m512i vc = _mm512_set1_epi64(c);
+    size_t i = 0, zeroed = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512i v = _mm512_loadu_si512((const void *) (src + i));
+        __m512i res = _mm512_mullo_epi64(v, vc);
+        __mmask8 became_zero = _mm512_test_epi64_mask(v, v) &
+                               ~_mm512_test_epi64_mask(res, res);
+        zeroed += (size_t) __builtin_popcount(became_zero);
+        _mm512_storeu_si512((void *) (dst + i), res);
+    }
+    return zeroed + ScaleScalar(dst + i, src + i, n - i, c);
+}
+
+/**
+ * Wersja AVX-512 CoeffNeg()
+ */
+__attribute__((target("avx512f")))
+static void NegAvx512(poly_coeff_t *dst, const poly_coeff_t *src, size_t n) {
+    __m512i zero = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512i v = _mm512_loadu_si512((const void *) (src + i));
+        _mm512_storeu_si512((void *) (dst + i), _mm512_sub_epi64(zero, v));
+    }
+    NegScalar(dst + i, src + i, n - i);
+}
+
+/**
+ * Wersja AVX-512 CoeffCompact()
+ */
+__attribute__((target("avx512f,avx512vl")))
+static size_t CompactAvx512(uint32_t *exps, poly_coeff_t *coeffs, size_t n) {
+    size_t i = 0, k = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512i v = _mm512_loadu_si512((const void *) (coeffs + i));
+        __m256i e = _mm256_loadu_si256((const __m256i *) (exps + i));
+        __mmask8 nonzero = _mm512_test_epi64_mask(v, v);
+        _mm512_mask_compressstoreu_epi64((void *) (coeffs + k), nonzero, v);
+        _mm256_mask_compressstoreu_epi32((void *) (exps + k), nonzero, e);
+        k += (size_t) __builtin_popcount(nonzero);
+    }
+    return CompactTail(exps, coeffs, n, i, k);
+}
+
+/**
+ * Zestaw operacji AVX-512
+ */
+static const CoeffKernels avx512_kernels = {
+        .name = "avx512", .scale = ScaleAvx512, .neg = NegAvx512,
+        .add_aligned = AddAlignedAvx2, .compact = CompactAvx512
+};
+
+#endif /* POLY_SIMD_X86 */
+
+/**
+ * Wybrany zestaw operacji
+ */
+static const CoeffKernels *kernels = &scalar_kernels;
+
+#ifdef POLY_SIMD_X86
+/**
+ * Wybiera zestaw operacji na podstawie możliwości procesora
+ * (przed rozpoczęciem działania programu, więc bez wyścigów)
+ */
+__attribute__((constructor))
+static void SelectKernels(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") &&
+        __builtin_cpu_supports("avx512dq") &&
+        __builtin_cpu_supports("avx512vl")) {
+        kernels = &avx512_kernels;
+    }
+    else if (__builtin_cpu_supports("avx2")) {
+        kernels = &avx2_kernels;
+    }
+}
+#endif
+
+size_t CoeffScale(poly_coeff_t dst[], const poly_coeff_t src[], size_t n,
+                  poly_coeff_t c) {
+    return kernels->scale(dst, src, n, c);
+}
+
+void CoeffNeg(poly_coeff_t dst[], const poly_coeff_t src[], size_t n) {
+    kernels->neg(dst, src, n);
+}
+
+size_t CoeffAddAligned(const uint32_t ea[], const uint32_t ka[],
+                       const poly_coeff_t ca[], const uint32_t eb[],
+                       const uint32_t kb[], const poly_coeff_t cb[],
+                       size_t n, uint32_t eo[], poly_coeff_t co[]) {
+    return kernels->add_aligned(ea, ka, ca, eb, kb, cb, n, eo, co);
+}
+
+size_t CoeffCompact(uint32_t exps[], poly_coeff_t coeffs[], size_t n) {
+    return kernels->compact(exps, coeffs, n);
+}
+
+const char *CoeffKernelsName(void) {
+    return kernels->name;
+}
@@ -0,0 +1,71 @@
+/** @file
+   Interfejs wektorowych operacji na tablicach współczynników
+
+   Operacje są wybierane przy starcie programu zależnie od możliwości
+   procesora (AVX-512, AVX2 lub wersja przenośna). Arytmetyka jest
+   wykonywana modulo 2^64, tak jak w przypadku przepełnienia @p long.
+
+   @copyright Uniwersytet Warszawski
+   @date 2026-10-19
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include "poly_packed.h"
+
+/**
+ * Mnoży tablicę współczynników przez stałą
+ * @param[out] dst : tablica wynikowa (może być równa @p src)
+ * @param[in] src : tablica współczynników
+ * @param[in] n : długość tablic
+ * @param[in] c : stała
+ * @return liczba niezerowych współczynników, które stały się zerami
+ */
+size_t CoeffScale(poly_coeff_t dst[], const poly_coeff_t src[], size_t n,
+                  poly_coeff_t c);
+
+/**
+ * Zamienia współczynniki na przeciwne
+ * @param[out] dst : tablica wynikowa (może być równa @p src)
+ * @param[in] src : tablica współczynników
+ * @param[in] n : długość tablic
+ */
+void CoeffNeg(poly_coeff_t dst[], const poly_coeff_t src[], size_t n);
+
+/**
+ * Dodaje współczynniki początkowych jednomianów dwóch wielomianów
+ * w zwartej postaci, dopóki jednomiany mają te same wykładniki i stałe
+ * współczynniki. Zatrzymuje się po jednomianie kończącym którykolwiek
+ * z wielomianów.
+ * @param[in] ea : wykładniki jednomianów pierwszego wielomianu
+ * @param[in] ka : pola `child` jednomianów pierwszego wielomianu
+ * @param[in] ca : współczynniki jednomianów pierwszego wielomianu
+ * @param[in] eb : wykładniki jednomianów drugiego wielomianu
+ * @param[in] kb : pola `child` jednomianów drugiego wielomianu
+ * @param[in] cb : współczynniki jednomianów drugiego wielomianu
+ * @param[in] n : liczba elementów, które można odczytać z każdej tablicy
+ * @param[out] eo : wykładniki sum (bez bitu @p PACKED_RUN_END)
+ * @param[out] co : sumy współczynników
+ * @return liczba dodanych jednomianów
+ */
+size_t CoeffAddAligned(const uint32_t ea[], const uint32_t ka[],
+                       const poly_coeff_t ca[], const uint32_t eb[],
+                       const uint32_t kb[], const poly_coeff_t cb[],
+                       size_t n, uint32_t eo[], poly_coeff_t co[]);
+
+/**
+ * Usuwa jednomiany o zerowych współczynnikach, zachowując kolejność
+ * pozostałych
+ * @param[in,out] exps : wykładniki
+ * @param[in,out] coeffs : współczynniki
+ * @param[in] n : liczba jednomianów
+ * @return liczba pozostawionych jednomianów
+ */
+size_t CoeffCompact(uint32_t exps[], poly_coeff_t coeffs[], size_t n);
+
+/**
+ * Zwraca nazwę wybranego zestawu operacji
+ * @return "avx512", "avx2" lub "scalar"
+ */
+const char *CoeffKernelsName(void);